@@ -1,272 +1,342 @@
-// 3DT.cpp
-// (c) Justin Thoreson
-// 8 October 2021
-
-#include <glad.h>
-#include <glfw3.h>
-#include <stdio.h>
-#include <VecMat.h>
-#include "GLXtras.h"
-
-// GPU identifiers
-GLuint vBuffer = 0;
-GLuint program = 0;
-
-// 3D Letter T
-float points[][3] = {
-    // Near
-    {.125f, .5f, -1}, {-.125f, .5f, -1}, {.875f, .5f, -1},
-    {-.875f, .5f, -1}, {.875f, .75f, -1}, {-.875f, .75f, -1},
-    {-.125f, -.5f, -1}, {.125f, -.75f, -1},
-
-    // Far
-    {.125f, .5f, 1}, {-.125f, .5f, 1}, {.875f, .5f, 1},
-    {-.875f, .5f, 1}, {.875f, .75f, 1}, {-.875f, .75f, 1},
-    {-.125f, -.5f, 1}, {.125f, -.75f, 1},
-};
-
-int triangles[][3] = {
-    // Near
-    {0, 1, 4}, {0, 2, 4}, {0, 1, 7}, {1, 3, 5},
-    {1, 4, 5}, {1, 6, 7},
-
-    // Top
-    {4, 5, 13}, {4, 12, 13},
-
-    // Sides
-    {3, 5, 13}, {3, 11, 13}, {2, 4, 12}, {2, 10, 12},
-    {0, 7, 8}, {7, 8, 15}, {1, 6, 9}, {6, 9, 14},
-
-    // Bottoms
-    {1, 3, 11}, {1, 9, 11}, {0, 2, 10}, {0, 8, 10},
-    {6, 7, 14}, {7, 14, 15},
-
-    // Far
-    {8, 9, 12}, {8, 10, 12}, {8, 9, 15}, {9, 11, 13},
-    {9, 12, 13}, {9, 14, 15},
-};
-
-float colors[][3] = { 
-    // Near
-    {1, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 0}, 
-    {1, 0, 1}, {0, 0, 0}, {1, 1, 0}, {1, 1, 0},
-
-    // Far
-    {1, 1, 0}, {1, 1, 0}, {0, 0, 0}, {1, 0, 1}, 
-    {0, 0, 0}, {1, 0, 1}, {1, 0, 0}, {1, 0, 0}
-};
-
-float fieldOfView = 30, cubeSize = .5f, cubeStretch = cubeSize;
-
-// Shaders 
-
-const char *vertexShader = R"(
-    #version 130
-    in vec3 point;
-    in vec3 color;
-    out vec4 vColor;
-    uniform mat4 view;
-    void main() {
-        gl_Position = view*vec4(point, 1);
-        vColor = vec4(color, 1);
-    }
-)";
-
-const char *pixelShader = R"(
-    #version 130
-    in vec4 vColor;
-    out vec4 pColor;
-    void main() {
-        pColor = vColor;
-    }
-)";
-
-void InitVertexBuffer() {
-    // make GPU buffer for points & colors, set it active buffer
-    glGenBuffers(1, &vBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
-    // allocate buffer memory to hold vertex locations and colors
-    int sPnts = sizeof(points), sCols = sizeof(colors);
-    glBufferData(GL_ARRAY_BUFFER, sPnts+sCols, NULL, GL_STATIC_DRAW);
-    // load data to the GPU
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, points);
-    // start at beginning of buffer, for length of points array
-    glBufferSubData(GL_ARRAY_BUFFER, sPnts, sCols, colors);
-    // start at end of points array, for length of colors array
-}
-
-bool InitShader() {
-    program = LinkProgramViaCode(&vertexShader, &pixelShader);
-    if (!program)
-        printf("can't init shader program\n");
-    return program != 0;
-}
-
-// Interaction
-
-// Rotate 3D letter, mouse click rotational continuity
-vec2 mouseDown(0, 0);                   // Location of last mouse down
-vec2 rotOld(0, 0), rotNew(0, 0);        // .x is rotation about Y-axis in degress, .y about X-axis
-float rotZ = 0;
-static float rotSpeed = .3f;
-
-// Move (translate) letter
-vec3 tranOld(0, 0, 0), tranNew(0, 0, -1);
-static float tranSpeed = .0025f;
-
-// Scale letter
-static float scalar = .3f;
-
-void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
-    // Called when mouse button pressed or released
-    if (action == GLFW_PRESS) {
-        // Save reference for MouseDrag
-        double x, y;
-        glfwGetCursorPos(w, &x, &y);
-        mouseDown = vec2((float) x, (float) y);
-    }
-    if (action == GLFW_RELEASE) {
-        // Save reference rotation
-        rotOld = rotNew;
-        tranOld = tranNew;
-    }
-}
-
-void MouseMove(GLFWwindow* w, double x, double y) {
-    if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-        // Compute mouse drag difference and update rotation
-        //vec2 dif((float) x - mouseDown.x, (float) y - mouseDown.y);
-        vec2 mouse((float)x, (float)y), dif = mouse - mouseDown;
-        bool shift = glfwGetKey(w, GLFW_KEY_LEFT_SHIFT) ||
-                     glfwGetKey(w, GLFW_KEY_RIGHT_SHIFT);
-        // Translate or rotate about X-axis, Y-axis
-        if (shift)
-            tranNew = tranOld + tranSpeed * vec3(dif.x, -dif.y, 0);
-        else
-            rotNew = rotOld + rotSpeed * dif;
-    }
-}
-
-void MouseWheel(GLFWwindow* w, double ignore, double spin) {
-    tranNew.z += spin > 0 ? -.1f : .1f;
-    tranOld = tranNew;
-}
-
-void Keyboard(GLFWwindow* w, int key, int scancode, int action, int mods) {
-    bool shift = mods & GLFW_MOD_SHIFT;
-    if (action == GLFW_PRESS) {
-        switch (key) {
-        case GLFW_KEY_ESCAPE:
-            glfwSetWindowShouldClose(w, GLFW_TRUE);
-            break;
-        case 'F':
-            fieldOfView += shift ? -5 : 5;
-            fieldOfView = fieldOfView < 5 ? 5 : fieldOfView > 150 ? 150 : fieldOfView;
-            break;
-        case 'S':
-            cubeStretch *= shift ? .9f : 1.1f;
-            cubeStretch = cubeStretch < .02f ? .02f : cubeStretch;
-            break;
-        }
-    }
-}
-
-// Application
-
-void Display(GLFWwindow *w) {
-    // clear background
-    glClearColor(.5, .5, .5, 1);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glClear(GL_DEPTH_BUFFER_BIT);
-    glEnable(GL_DEPTH_TEST);
-    // access GPU vertex buffer
-    glUseProgram(program);
-    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
-    // associate position input to shader with position array in vertex buffer
-    VertexAttribPointer(program, "point", 3, 0, (void*) 0);
-    // associate color input to shader with color array in vertex buffer
-    VertexAttribPointer(program, "color", 3, 0, (void*) sizeof(points));
-    // Get screen size
-    int screenWidth, screenHeight;
-    glfwGetWindowSize(w, &screenWidth, &screenHeight);
-    // Compute aspect ratio
-    float halfWidth = screenWidth / 2;
-    float aspectRatio = (float)halfWidth / (float)screenHeight;
-    // Update view transformation
-    float nearDist = .001f, farDist = 500;
-    mat4 persp = Perspective(fieldOfView, aspectRatio, nearDist, farDist);
-    mat4 scale = Scale(cubeSize, cubeSize, cubeStretch);
-    mat4 rot = RotateY(rotNew.x) * RotateX(rotNew.y);
-    mat4 tran = Translate(tranNew);
-    mat4 modelView = tran * rot * scale;
-    mat4 view = persp * modelView;
-    // Draw solid cube elements
-    SetUniform(program, "view", view);
-    glViewport(0, 0, halfWidth, screenHeight);
-    int nVertices = sizeof(triangles) / sizeof(int);
-    glDrawElements(GL_TRIANGLES, nVertices, GL_UNSIGNED_INT, triangles);
-    // Draw outline cube elements
-    glViewport(halfWidth, 0, halfWidth, screenHeight);
-    glLineWidth(5);
-    for (int i = 0; i < 28; i++)
-        glDrawElements(GL_LINE_LOOP, 3, GL_UNSIGNED_INT, &triangles[i]);
-}
-
-void ErrorGFLW(int id, const char *reason) {
-    printf("GFLW error %i: %s\n", id, reason);
-}
-
-void Close() {
-    // unbind vertex buffer and free GPU memory
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &vBuffer);
-}
-
-const char* credit = "\
-	Created by Justin Thoreson\n\
--------------------------------------------------------\n\
-";
-
-const char* usage = "\n\
-                S & SHIFT + S: stretch/shrink T\n\
-                F & SHIFT + F: change field of view\n\
-            LEFT-CLICK + DRAG: rotate view\n\
-    SHIFT + LEFT-CLICK + DRAG: move T\n\
-                       SCROLL: resize T/zoom in and out\n\
-";
-
-int main() {
-    glfwSetErrorCallback(ErrorGFLW);
-    if (!glfwInit())
-        return 1;
-    glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
-    GLFWwindow *window = glfwCreateWindow(750, 750, "3DT", NULL, NULL);
-    if (!window) {
-        glfwTerminate();
-        return 1;
-    }
-    glfwMakeContextCurrent(window);
-    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
-    printf("GL version: %s\n", glGetString(GL_VERSION));
-    printf("\n%s\n", credit);
-    printf("Usage:\n%s\n", usage);
-    PrintGLErrors();
-    if (!InitShader())
-        return 0;
-    InitVertexBuffer();
-    // Set callbacks for device interaction
-    glfwSetMouseButtonCallback(window, MouseButton);
-    glfwSetCursorPosCallback(window, MouseMove);
-    glfwSetScrollCallback(window, MouseWheel);
-    glfwSetKeyCallback(window, Keyboard);
-    glfwSwapInterval(1); // ensure no generated frame backlog
-    // event loop
-    while (!glfwWindowShouldClose(window)) {
-        Display(window);
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-    }
-    Close();
-    glfwDestroyWindow(window);
-    glfwTerminate();
-}
+// 3DT.cpp
+// (c) Justin Thoreson
+// 8 October 2021
+
+#include <glad.h>
+#include <glfw3.h>
+#include <stdio.h>
+#include <VecMat.h>
+#include "GLXtras.h"
+#include "ArcCamera.h"
+#include "GLCount.h"
+#include "Extrude.h"
+#include "Wireframe.h"
+#include "MultiView.h"
+
+// GPU identifiers
+GLuint vBuffer = 0, iBuffer = 0;
+GLuint program = 0, wireProgram = 0, layeredProgram = 0;
+
+// Views: solid left, wire right; or solid from four directions, one layered draw where supported
+MultiView multiView;
+bool quad = false;
+
+// Right view: unique edges in one GL_LINES draw, or solid+wire in one barycentric pass
+Wireframe wireframe;
+bool solidWire = false;
+
+// Outline of letter T, extruded into a 3D mesh at startup
+std::vector<vec2> tOutline = {
+    {-.875f, .75f}, {-.875f, .5f}, {-.125f, .5f}, {-.125f, -.5f},
+    {.125f, -.75f}, {.125f, .5f}, {.875f, .5f}, {.875f, .75f}
+};
+ExtrudedMesh letter;
+
+float fieldOfView = 30, cubeSize = .5f, cubeStretch = cubeSize;
+
+// Shaders 
+
+const char *vertexShader = R"(
+    #version 130
+    in vec3 point;
+    in vec3 color;
+    out vec4 vColor;
+    uniform mat4 view;
+    void main() {
+        gl_Position = view*vec4(point, 1);
+        vColor = vec4(color, 1);
+    }
+)";
+
+const char *pixelShader = R"(
+    #version 130
+    in vec4 vColor;
+    out vec4 pColor;
+    void main() {
+        pColor = vColor;
+    }
+)";
+
+vec3 VertexColor(vec3 p, vec3 n) {
+    // Gradient across the letter (red, magenta above; cyan, yellow below), walls shaded by facing
+    vec3 size = letter.bounds.max - letter.bounds.min;
+    float u = (p.x - letter.bounds.min.x) / size.x, v = (p.y - letter.bounds.min.y) / size.y;
+    vec3 top = (1 - u) * vec3(1, 0, 0) + u * vec3(1, 0, 1), bottom = (1 - u) * vec3(0, 1, 1) + u * vec3(1, 1, 0);
+    return (.6f + .4f * fabsf(n.z)) * (v * top + (1 - v) * bottom);
+}
+
+void InitVertexBuffer() {
+    // extrude outline: caps, walls, welded and indexed
+    letter = ExtrudeOutlines({ tOutline }, {}, 2);
+    std::vector<vec3> colors;
+    for (size_t i = 0; i < letter.points.size(); i++)
+        colors.push_back(VertexColor(letter.points[i], letter.normals[i]));
+    // make GPU buffer for points & colors, set it active buffer
+    glGenBuffers(1, &vBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
+    // allocate buffer memory to hold vertex locations and colors
+    int sPnts = (int) (letter.points.size() * sizeof(vec3)), sCols = (int) (colors.size() * sizeof(vec3));
+    glBufferData(GL_ARRAY_BUFFER, sPnts+sCols, NULL, GL_STATIC_DRAW);
+    // load data to the GPU
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, letter.points.data());
+    // start at beginning of buffer, for length of points array
+    glBufferSubData(GL_ARRAY_BUFFER, sPnts, sCols, colors.data());
+    // start at end of points array, for length of colors array
+    // triangle indices in their own buffer
+    glGenBuffers(1, &iBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, letter.triangles.size() * sizeof(int3), letter.triangles.data(), GL_STATIC_DRAW);
+    // edges shared by triangles, or by cap and wall copies of a vertex, once
+    wireframe.Init(letter.triangles.data(), (int) letter.triangles.size(), letter.points.data(), (int) letter.points.size());
+}
+
+const char *wireGeometryShader = WIRE_GEOMETRY;
+
+const char *wirePixelShader = "#version 150\n" WIRE_SHADE R"(
+    in vec4 gColor;
+    out vec4 pColor;
+    void main() {
+        pColor = WireShade(gColor);
+    }
+)";
+
+const char *layeredVertexShader = "#version 410\n" MULTIVIEW_VERTEX R"(
+    in vec3 point;
+    in vec3 color;
+    out vec4 vColor;
+    void main() {
+        gl_Position = MultiView()*vec4(point, 1);
+        vColor = vec4(color, 1);
+    }
+)";
+
+const char *layeredGeometryShader = MULTIVIEW_GEOMETRY;
+
+const char *layeredPixelShader = R"(
+    #version 410
+    in vec4 gColor;
+    out vec4 pColor;
+    void main() {
+        pColor = gColor;
+    }
+)";
+
+bool InitShader() {
+    program = LinkProgramViaCode(&vertexShader, &pixelShader);
+    if (multiView.Supported())
+        layeredProgram = LinkProgramViaCode(&layeredVertexShader, NULL, NULL, &layeredGeometryShader, &layeredPixelShader);
+    wireProgram = LinkProgramViaCode(&vertexShader, NULL, NULL, &wireGeometryShader, &wirePixelShader);
+    if (!program || !wireProgram)
+        printf("can't init shader program\n");
+    return program != 0 && wireProgram != 0;
+}
+
+// Interaction
+
+// Rotate (arcball), move and zoom 3D letter; view drawn into left half of window
+ArcCamera camera(375, 750, vec3(0, 0, 0), vec3(0, 0, -1), fieldOfView);
+int viewChanges = -1;                   // camera.Changes() when view last uploaded
+bool stretchChanged = true;
+
+// Scale letter
+static float scalar = .3f;
+
+void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
+    // Called when mouse button pressed or released
+    if (action == GLFW_PRESS) {
+        // Save reference for MouseDrag
+        double x, y;
+        glfwGetCursorPos(w, &x, &y);
+        camera.MouseDown((int) x, (int) y);
+    }
+    if (action == GLFW_RELEASE) {
+        // Save reference rotation
+        camera.MouseUp();
+    }
+}
+
+void MouseMove(GLFWwindow* w, double x, double y) {
+    if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
+        bool shift = glfwGetKey(w, GLFW_KEY_LEFT_SHIFT) ||
+                     glfwGetKey(w, GLFW_KEY_RIGHT_SHIFT);
+        // Translate or rotate
+        camera.MouseDrag((int) x, (int) y, shift);
+    }
+}
+
+void MouseWheel(GLFWwindow* w, double ignore, double spin) {
+    camera.MouseWheel(spin > 0, true);
+}
+
+void Resize(GLFWwindow* w, int width, int height) {
+    camera.Resize(width / 2, quad ? height / 2 : height);
+}
+
+void Keyboard(GLFWwindow* w, int key, int scancode, int action, int mods) {
+    bool shift = mods & GLFW_MOD_SHIFT;
+    if (action == GLFW_PRESS) {
+        switch (key) {
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(w, GLFW_TRUE);
+            break;
+        case 'F':
+            fieldOfView += shift ? -5 : 5;
+            fieldOfView = fieldOfView < 5 ? 5 : fieldOfView > 150 ? 150 : fieldOfView;
+            camera.SetFOV(fieldOfView);
+            break;
+        case 'S':
+            cubeStretch *= shift ? .9f : 1.1f;
+            cubeStretch = cubeStretch < .02f ? .02f : cubeStretch;
+            stretchChanged = true;
+            break;
+        case 'V': {
+            quad = !quad;
+            int width, height;
+            glfwGetWindowSize(w, &width, &height);
+            Resize(w, width, height);
+            printf("Views: %s\n", quad ? "four solid" : "solid and wire");
+            break;
+        }
+        case 'W':
+            solidWire = !solidWire;
+            printf("Right view: %s\n", solidWire ? "solid+wire, one barycentric pass" : "unique edges, one GL_LINES draw");
+            break;
+        }
+    }
+}
+
+// Application
+
+void Display(GLFWwindow *w) {
+    // clear background
+    glClearColor(.5, .5, .5, 1);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    // access GPU vertex and index buffers
+    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iBuffer);
+    // associate position and color inputs to shaders with position and color arrays in vertex buffer
+    void *colorOffset = (void*) (letter.points.size() * sizeof(vec3));
+    for (GLuint p : { program, layeredProgram })
+        if (p) {
+            VertexAttribPointer(p, "point", 3, 0, (void*) 0);
+            VertexAttribPointer(p, "color", 3, 0, colorOffset);
+        }
+    // Get screen size
+    int screenWidth, screenHeight;
+    glfwGetWindowSize(w, &screenWidth, &screenHeight);
+    int halfWidth = screenWidth / 2, halfHeight = screenHeight / 2;
+    // Views: camera into each viewport (quad: front, side, back, top)
+    std::vector<View> views;
+    if (quad) {
+        mat4 turns[] = { mat4(), RotateY(90), RotateY(180), RotateX(90) };
+        for (int i = 0; i < 4; i++)
+            views.push_back(View((i % 2) * halfWidth, (1 - i / 2) * halfHeight, halfWidth, halfHeight, camera.fullview * turns[i]));
+    }
+    else {
+        views.push_back(View(0, 0, halfWidth, screenHeight, camera.fullview));
+        views.push_back(View(halfWidth, 0, halfWidth, screenHeight, camera.fullview));
+    }
+    multiView.SetViews(views);
+    // Letter transform and culling, once for all views
+    mat4 model = Scale(cubeSize, cubeSize, cubeStretch);
+    unsigned visible = multiView.Cull(model, letter.bounds);
+    int nTriangles = (int) letter.triangles.size();
+    // Draw solid cube elements: every view, or the left
+    multiView.Draw(layeredProgram, program, model, quad ? visible : visible & 1, [nTriangles](int instances) {
+        glDrawElementsInstanced(GL_TRIANGLES, 3 * nTriangles, GL_UNSIGNED_INT, (void*) 0, instances);
+    });
+    // Upload solid+wire view transformation only if camera or stretch changed
+    if (camera.Changed(viewChanges) || stretchChanged) {
+        glUseProgram(wireProgram);
+        SetUniform(wireProgram, "view", camera.fullview * model);
+        stretchChanged = false;
+    }
+    if (quad || !(visible & 2))
+        return;
+    // Draw outline cube elements
+    if (solidWire) {
+        multiView.Viewport(1);
+        glUseProgram(wireProgram);
+        VertexAttribPointer(wireProgram, "point", 3, 0, (void*) 0);
+        VertexAttribPointer(wireProgram, "color", 3, 0, colorOffset);
+        glDrawElements(GL_TRIANGLES, 3 * nTriangles, GL_UNSIGNED_INT, (void*) 0);
+    }
+    else {
+        // lines are not layered: per-view path, its view uniform uploaded only on change
+        glLineWidth(5);
+        multiView.Draw(0, program, model, visible & 2, [](int) { wireframe.Draw(); });
+    }
+}
+
+void ErrorGFLW(int id, const char *reason) {
+    printf("GFLW error %i: %s\n", id, reason);
+}
+
+void Close() {
+    // unbind vertex buffer and free GPU memory
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &vBuffer);
+    glDeleteBuffers(1, &iBuffer);
+    wireframe.Release();
+    multiView.PrintStats("Views");
+    PrintExtrudeStats("Extrude");
+}
+
+const char* credit = "\
+	Created by Justin Thoreson\n\
+-------------------------------------------------------\n\
+";
+
+const char* usage = "\n\
+                S & SHIFT + S: stretch/shrink T\n\
+                F & SHIFT + F: change field of view\n\
+                            W: toggle edges/solid+wire (right view)\n\
+                            V: toggle two views/four solid views\n\
+            LEFT-CLICK + DRAG: rotate view\n\
+    SHIFT + LEFT-CLICK + DRAG: move T\n\
+                       SCROLL: resize T/zoom in and out\n\
+";
+
+int main() {
+    glfwSetErrorCallback(ErrorGFLW);
+    if (!glfwInit())
+        return 1;
+    glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
+    GLFWwindow *window = glfwCreateWindow(750, 750, "3DT", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    GLCountInstall(); // count GL calls per frame
+    printf("GL version: %s\n", glGetString(GL_VERSION));
+    printf("\n%s\n", credit);
+    printf("Usage:\n%s\n", usage);
+    PrintGLErrors();
+    if (!InitShader())
+        return 0;
+    InitVertexBuffer();
+    camera.tranSpeed = .0025f;
+    camera.zoomSpeed = .1f;
+    // Set callbacks for device interaction
+    glfwSetMouseButtonCallback(window, MouseButton);
+    glfwSetCursorPosCallback(window, MouseMove);
+    glfwSetScrollCallback(window, MouseWheel);
+    glfwSetKeyCallback(window, Keyboard);
+    glfwSetWindowSizeCallback(window, Resize);
+    glfwSwapInterval(1); // ensure no generated frame backlog
+    // event loop
+    while (!glfwWindowShouldClose(window)) {
+        Display(window);
+        GLCountNewFrame();
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+    Close();
+    GLCountPrint("3DT");
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
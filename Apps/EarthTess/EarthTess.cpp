@@ -1,211 +1,436 @@
-// EarthTess.cpp
-// (c) Justin Thoreson
-// 8 November 2021
-
-#include <glad.h>
-#include <GLFW/glfw3.h>
-#include <stdio.h>
-#include "Camera.h"
-#include "Draw.h"
-#include "GLXtras.h"
-#include "Misc.h"
-#include "Widgets.h"
-#include "VecMat.h"
-
-// display parameters
-int         winWidth = 800, winHeight = 600;
-Camera      camera(winWidth, winHeight, vec3(0, 0, 0), vec3(0, 0, -7));
-
-// shading
-GLuint      program = 0;
-int			textureName = 0, textureUnit = 0;
-const char *textureFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/Earth.jpg";
-
-// interaction
-vec3        light(-1.5f, 1.5
-	, 1);
-void       *picked = NULL;
-Mover       mover;
-
-// vertex shader (no op)
-const char *vShaderCode = R"(
-	#version 130
-	void main() {
-		gl_Position = vec4(0); // no-op
-	}
-)";
-
-// tessellation evaluation
-const char *teShaderCode = R"(
-	#version 400
-	layout (quads, equal_spacing, ccw) in;
-	uniform mat4 modelview, persp;
-	uniform float dt;
-	out vec3 point, normal;
-	out vec2 uv;
-	vec3 PtFromWhateverThisTurnsOutToBe(float u, float v) {
-		// u is longitude
-		// v is latitude (PI/2 = N. pole, 0 = equator, -PI/2 = S. pole)
-		float PI = 3.141592;
-		float elevation = PI*v-PI/2;
-		float y = sin(elevation);
-		float angle = 2*PI*(1-u);
-		// Tessellate back and forth from sphere to cylinder
-		float tessTime = cos(sin(dt)*elevation);
-		float x = tessTime*cos(angle), z = tessTime*sin(angle); 
-		return vec3(x, y, z);
-	}
-	void main() {
-		uv = gl_TessCoord.st;
-		vec3 p = PtFromWhateverThisTurnsOutToBe(uv.s, uv.t);
-		// Adjust the normals as the shape changes for better shading
-		vec3 n = vec3(p.x, abs(sin(dt))*p.y, p.z);	
-		point = (modelview*vec4(p, 1)).xyz;
-		normal = (modelview*vec4(n, 0)).xyz;
-		gl_Position = persp*vec4(point, 1);
-	}
-)";
-
-// pixel shader
-const char *pShaderCode = R"(
-	#version 130
-	in vec3 point, normal;
-	in vec2 uv;
-	uniform sampler2D textureMap;
-	uniform vec3 light;
-	void main() {
-		vec3 N = normalize(normal);             // surface normal
-		vec3 L = normalize(light-point);        // light vector
-		vec3 E = normalize(point);              // eye vertex
-		vec3 R = reflect(L, N);                 // highlight vector
-		float dif = max(0, dot(N, L));          // one-sided diffuse
-		float spec = pow(max(0, dot(E, R)), 50); 
-		float ad = clamp(.15+dif, 0, 1);
-		vec3 texColor = texture(textureMap, uv).rgb;
-		gl_FragColor = vec4(ad*texColor+vec3(spec), 1);
-	}
-)";
-
-// display
-
-time_t start = clock();
-
-void Display() {
-	// background, blending, zbuffer
-	glClearColor(.6, .6, .6, 1);
-	glClear(GL_COLOR_BUFFER_BIT);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_DEPTH_TEST);
-	glClear(GL_DEPTH_BUFFER_BIT);
-	glUseProgram(program);
-	// update matrices
-	float dt = (float)(clock() - start) / CLOCKS_PER_SEC;
-	mat4 m = RotateY(-30*dt)*RotateZ(-23.4)*RotateY(180 * dt); // Earth's rotation, then axis tilt, then axis rotation
-	SetUniform(program, "modelview", camera.modelview*m);
-	SetUniform(program, "persp", camera.persp);
-	SetUniform(program, "dt", dt);
-	// transform light and send to pixel shader
-	vec4 hLight = camera.modelview*vec4(light, 1);
-	glUniform3fv(glGetUniformLocation(program, "light"), 1, (float *) &hLight);
-	// set texture
-	SetUniform(program, "textureMap", textureUnit);
-	glActiveTexture(GL_TEXTURE0+textureUnit);       // active texture corresponds with textureUnit
-	glBindTexture(GL_TEXTURE_2D, textureName);      // bind active texture to textureName
-	// tessellate patch
-	glPatchParameteri(GL_PATCH_VERTICES, 4);
-	float res = 25, outerLevels[] = {res, res, res, res}, innerLevels[] = {res, res};
-	glPatchParameterfv(GL_PATCH_DEFAULT_OUTER_LEVEL, outerLevels);
-	glPatchParameterfv(GL_PATCH_DEFAULT_INNER_LEVEL, innerLevels);
-	glDrawArrays(GL_PATCHES, 0, 4);
-	// light
-	glDisable(GL_DEPTH_TEST);
-	UseDrawShader(camera.fullview);
-	Disk(light, 12, vec3(1, 0, 0));
-	glFlush();
-}
-
-// mouse
-
-void MouseButton(GLFWwindow *w, int butn, int action, int mods) {
-	double x, y;
-	glfwGetCursorPos(w, &x, &y);
-	y = winHeight-y; // invert y for upward-increasing screen space
-	picked = NULL;
-	if (action == GLFW_RELEASE)
-		camera.MouseUp();
-	if (action == GLFW_PRESS) {
-		if (MouseOver(x, y, light, camera.fullview)) {
-			mover.Down(&light, (int) x, (int) y, camera.modelview, camera.persp);
-			picked = &mover;
-		}
-		else {
-			picked = &camera;
-			camera.MouseDown(x, y);
-		}
-	}
-}
-
-void MouseMove(GLFWwindow *w, double x, double y) {
-	if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-		y = winHeight-y;
-		if (picked == &mover)
-			mover.Drag((int) x, (int) y, camera.modelview, camera.persp);
-		if (picked == &camera)
-			camera.MouseDrag((int) x, (int) y, Shift());
-	}
-}
-
-void MouseWheel(GLFWwindow *w, double ignore, double spin) {
-	camera.MouseWheel(spin > 0, Shift());
-}
-
-// application
-
-void Resize(GLFWwindow *window, int width, int height) {
-	camera.Resize(winWidth = width, winHeight = height);
-	glViewport(0, 0, width, height);
-}
-
-const char* credit = "\
-	Created by Justin Thoreson\n\
--------------------------------------------------------\n\
-";
-
-const char* usage = "\n\
-                 DRAG RED DOT: move light source\n\
-            LEFT-CLICK + DRAG: rotate view\n\
-    SHIFT + LEFT-CLICK + DRAG: move objects\n\
-                       SCROLL: rotate view\n\
-               SHIFT + SCROLL: zoom in and out\n\
-";
-
-int main(int ac, char **av) {
-	// init app window
-	if (!glfwInit())
-		return 1;
-	glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
-	GLFWwindow *w = glfwCreateWindow(winWidth, winHeight, "Earth Tessellation", NULL, NULL);
-	glfwSetWindowPos(w, 100, 100);
-	glfwMakeContextCurrent(w);
-	// init OpenGL, shader program, texture
-	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
-	program = LinkProgramViaCode(&vShaderCode, NULL, &teShaderCode, NULL, &pShaderCode);
-	textureName = LoadTexture(textureFilename, textureUnit);
-	// callbacks
-	glfwSetCursorPosCallback(w, MouseMove);
-	glfwSetMouseButtonCallback(w, MouseButton);
-	glfwSetScrollCallback(w, MouseWheel);
-	glfwSetWindowSizeCallback(w, Resize);
-	printf("\n%s\n", credit);
-	printf("Usage:\n%s\n", usage);
-	// event loop
-	glfwSwapInterval(1);
-	while (!glfwWindowShouldClose(w)) {
-		Display();
-		glfwPollEvents();
-		glfwSwapBuffers(w);
-	}
-	glfwDestroyWindow(w);
-	glfwTerminate();
-}
+// EarthTess.cpp
+// (c) Justin Thoreson
+// 8 November 2021
+
+#include <glad.h>
+#include <GLFW/glfw3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ArcCamera.h"
+#include "Draw.h"
+#include "GLXtras.h"
+#include "Misc.h"
+#include "Widgets.h"
+#include "VecMat.h"
+#include "GLCount.h"
+#include "ProgramCache.h"
+#include "TextureLoader.h"
+#include "VirtualTexture.h"
+
+// display parameters
+int         winWidth = 800, winHeight = 600;
+ArcCamera   camera(winWidth, winHeight, vec3(0, 0, 0), vec3(0, 0, -7));
+int         viewChanges = -1; // camera.Changes() when persp last uploaded
+
+// shading
+GLuint      program = 0;
+int			textureName = 0, textureUnit = 0;
+TextureLoader textureLoader; // Earth loaded by workers, uploaded in slices per frame
+const char *textureFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/Earth.jpg";
+
+// virtual texture (-virtual [file.vt] [-budget MB] [-grid columns image...]): tiles streamed by feedback, for imagery too large for one texture
+bool        virtualOn = false;
+const char *virtualFilename = "Earth.vt"; // built from textureFilename if missing
+int         virtualBudget = 64;           // MB of atlas
+std::vector<std::string> virtualSources; // -grid columns image...: row-major tiles of imagery, built into the file
+int         virtualColumns = 1;
+GLuint      feedbackProgram = 0;
+VirtualTexture virtualTexture;
+
+// interaction
+vec3        light(-1.5f, 1.5
+	, 1);
+void       *picked = NULL;
+Mover       mover;
+
+// adaptive tessellation: globe split into patches, each edge's level from its on-screen length
+const int   patchesU = 16, patchesV = 8;  // longitude, latitude
+float       pixelsPerEdge = 12;           // target triangle edge length, in pixels
+bool        cullPatches = true;           // level 0 for patches off screen or facing away
+GLuint      primitivesQuery = 0;          // triangles generated, read when available
+GLuint      lastPrimitives = 0;
+bool        queryPending = false;
+
+// vertex shader: patch corners from vertex id
+const char *vShaderCode = R"(
+	#version 130
+	uniform int patchesU, patchesV;
+	out vec2 vUV;
+	void main() {
+		// four corners per patch, counter-clockwise from (low u, low v)
+		int p = gl_VertexID/4, corner = gl_VertexID%4;
+		ivec2 c = ivec2(p%patchesU+int(corner == 1 || corner == 2), p/patchesU+int(corner >= 2));
+		vUV = vec2(c)/vec2(patchesU, patchesV);
+		gl_Position = vec4(0);
+	}
+)";
+
+// surface, shared by tessellation control (levels, culling) and evaluation
+#define SURFACE \
+	"uniform float dt;\n" \
+	"vec3 PtFromWhateverThisTurnsOutToBe(float u, float v) {\n" \
+	"    // u is longitude\n" \
+	"    // v is latitude (PI/2 = N. pole, 0 = equator, -PI/2 = S. pole)\n" \
+	"    float PI = 3.141592;\n" \
+	"    float elevation = PI*v-PI/2;\n" \
+	"    float y = sin(elevation);\n" \
+	"    float angle = 2*PI*(1-u);\n" \
+	"    // Tessellate back and forth from sphere to cylinder\n" \
+	"    float tessTime = cos(sin(dt)*elevation);\n" \
+	"    float x = tessTime*cos(angle), z = tessTime*sin(angle);\n" \
+	"    return vec3(x, y, z);\n" \
+	"}\n" \
+	"vec3 NormalAt(vec3 p) {\n" \
+	"    // Adjust the normals as the shape changes for better shading\n" \
+	"    return vec3(p.x, abs(sin(dt))*p.y, p.z);\n" \
+	"}\n"
+
+// tessellation control
+const char *tcShaderCode = "#version 400\n" SURFACE R"(
+	layout (vertices = 4) out;
+	in vec2 vUV[];
+	out vec2 tcUV[];
+	uniform mat4 modelview, persp;
+	uniform vec2 viewport;
+	uniform float pixelsPerEdge;
+	uniform bool cull;
+	vec4 Clip(vec2 uv) {
+		return persp*modelview*vec4(PtFromWhateverThisTurnsOutToBe(uv.s, uv.t), 1);
+	}
+	float Level(vec2 a, vec2 b) {
+		// projected length of edge ab, through its midpoint to follow the curve
+		vec4 ca = Clip(a), cm = Clip(.5*(a+b)), cb = Clip(b);
+		if (min(ca.w, min(cm.w, cb.w)) <= 0)
+			return 64.;
+		vec2 sa = .5*viewport*ca.xy/ca.w, sm = .5*viewport*cm.xy/cm.w, sb = .5*viewport*cb.xy/cb.w;
+		return clamp((length(sm-sa)+length(sb-sm))/pixelsPerEdge, 1., 64.);
+	}
+	bool Culled(vec2 lo, vec2 hi) {
+		// 3x3 samples: all facing away (with margin), or all beyond one side of the view
+		bool away = true;
+		int left = 0, right = 0, below = 0, above = 0;
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++) {
+				vec2 uv = mix(lo, hi, vec2(i, j)/2.);
+				vec3 p = PtFromWhateverThisTurnsOutToBe(uv.s, uv.t);
+				vec3 e = (modelview*vec4(p, 1)).xyz, n = (modelview*vec4(NormalAt(p), 0)).xyz;
+				if (dot(e, n) <= .2*length(e)*length(n))
+					away = false;
+				vec4 c = persp*vec4(e, 1);
+				float w = 1.1*abs(c.w);             // margin for the surface bulging between samples
+				left += int(c.x < -w);
+				right += int(c.x > w);
+				below += int(c.y < -w);
+				above += int(c.y > w);
+			}
+		return away || left == 9 || right == 9 || below == 9 || above == 9;
+	}
+	void main() {
+		tcUV[gl_InvocationID] = vUV[gl_InvocationID];
+		if (gl_InvocationID != 0)
+			return;
+		vec2 lo = vUV[0], hi = vUV[2];
+		if (cull && Culled(lo, hi)) {
+			gl_TessLevelOuter[0] = gl_TessLevelOuter[1] = gl_TessLevelOuter[2] = gl_TessLevelOuter[3] = 0.;
+			gl_TessLevelInner[0] = gl_TessLevelInner[1] = 0.;
+			return;
+		}
+		// edges u = lo, v = lo, u = hi, v = hi; endpoints in the order a neighbor sharing the edge uses
+		gl_TessLevelOuter[0] = Level(lo, vec2(lo.s, hi.t));
+		gl_TessLevelOuter[1] = Level(lo, vec2(hi.s, lo.t));
+		gl_TessLevelOuter[2] = Level(vec2(hi.s, lo.t), hi);
+		gl_TessLevelOuter[3] = Level(vec2(lo.s, hi.t), hi);
+		gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+		gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+	}
+)";
+
+// tessellation evaluation
+const char *teShaderCode = "#version 400\n" SURFACE R"(
+	layout (quads, equal_spacing, ccw) in;
+	in vec2 tcUV[];
+	uniform mat4 modelview, persp;
+	out vec3 point, normal;
+	out vec2 uv;
+	void main() {
+		uv = mix(tcUV[0], tcUV[2], gl_TessCoord.st);
+		vec3 p = PtFromWhateverThisTurnsOutToBe(uv.s, uv.t);
+		vec3 n = NormalAt(p);
+		point = (modelview*vec4(p, 1)).xyz;
+		normal = (modelview*vec4(n, 0)).xyz;
+		gl_Position = persp*vec4(point, 1);
+	}
+)";
+
+// pixel shader
+const char *pShaderCode = R"(
+	#version 130
+	in vec3 point, normal;
+	in vec2 uv;
+	uniform sampler2D textureMap;
+	uniform vec3 light;
+	void main() {
+		vec3 N = normalize(normal);             // surface normal
+		vec3 L = normalize(light-point);        // light vector
+		vec3 E = normalize(point);              // eye vertex
+		vec3 R = reflect(L, N);                 // highlight vector
+		float dif = max(0, dot(N, L));          // one-sided diffuse
+		float spec = pow(max(0, dot(E, R)), 50); 
+		float ad = clamp(.15+dif, 0, 1);
+		vec3 texColor = texture(textureMap, uv).rgb;
+		gl_FragColor = vec4(ad*texColor+vec3(spec), 1);
+	}
+)";
+
+// pixel shader, sampling the virtual texture
+const char *pVirtualCode = "#version 130\n" VT_LOOKUP R"(
+	in vec3 point, normal;
+	in vec2 uv;
+	uniform vec3 light;
+	void main() {
+		vec3 N = normalize(normal);
+		vec3 L = normalize(light-point);
+		vec3 E = normalize(point);
+		vec3 R = reflect(L, N);
+		float dif = max(0, dot(N, L));
+		float spec = pow(max(0, dot(E, R)), 50);
+		float ad = clamp(.15+dif, 0, 1);
+		vec3 texColor = VirtualTexture(uv).rgb;
+		gl_FragColor = vec4(ad*texColor+vec3(spec), 1);
+	}
+)";
+
+// feedback pixel shader: the page each pixel would sample
+const char *pFeedbackCode = "#version 130\n" VT_LOOKUP VT_FEEDBACK R"(
+	in vec2 uv;
+	out uvec4 pFeedback;
+	void main() {
+		pFeedback = VirtualFeedback(uv);
+	}
+)";
+
+// display
+
+time_t start = clock();
+
+void DrawEarth(GLuint p, mat4 modelview, float dt) {
+	SetUniform(p, "modelview", modelview);
+	SetUniform(p, "dt", dt);
+	SetUniform(p, "patchesU", patchesU);
+	SetUniform(p, "patchesV", patchesV);
+	SetUniform(p, "viewport", vec2((float) winWidth, (float) winHeight));
+	SetUniform(p, "pixelsPerEdge", pixelsPerEdge);
+	SetUniform(p, "cull", cullPatches);
+	// tessellate patches, levels set per patch by control shader
+	glPatchParameteri(GL_PATCH_VERTICES, 4);
+	glDrawArrays(GL_PATCHES, 0, 4*patchesU*patchesV);
+}
+
+void Display() {
+	// update matrices
+	float dt = (float)(clock() - start) / CLOCKS_PER_SEC;
+	mat4 m = RotateY(-30*dt)*RotateZ(-23.4)*RotateY(180 * dt); // Earth's rotation, then axis tilt, then axis rotation
+	if (virtualOn) {
+		// pages wanted this frame, read back next frame
+		virtualTexture.Update();
+		glEnable(GL_DEPTH_TEST);
+		glUseProgram(AwaitProgram(feedbackProgram));
+		SetUniform(feedbackProgram, "persp", camera.persp);
+		virtualTexture.Use(feedbackProgram, true);
+		virtualTexture.BeginFeedback(winWidth, winHeight);
+		DrawEarth(feedbackProgram, camera.modelview*m, dt);
+		virtualTexture.EndFeedback();
+	}
+	// clear color and depth together, blending, zbuffer
+	glClearColor(.6, .6, .6, 1);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glEnable(GL_DEPTH_TEST);
+	glUseProgram(AwaitProgram(program));
+	if (camera.Changed(viewChanges))
+		SetUniform(program, "persp", camera.persp);
+	// transform light and send to pixel shader
+	vec4 hLight = camera.modelview*vec4(light, 1);
+	glUniform3fv(glGetUniformLocation(program, "light"), 1, (float *) &hLight);
+	// set texture
+	if (virtualOn)
+		virtualTexture.Use(program);
+	else {
+		SetUniform(program, "textureMap", textureUnit);
+		glActiveTexture(GL_TEXTURE0+textureUnit);   // active texture corresponds with textureUnit
+		glBindTexture(GL_TEXTURE_2D, textureName);  // bind active texture to textureName
+	}
+	// count triangles generated, result read when available (a frame or more late)
+	if (queryPending) {
+		GLuint ready = 0;
+		glGetQueryObjectuiv(primitivesQuery, GL_QUERY_RESULT_AVAILABLE, &ready);
+		if (ready) {
+			glGetQueryObjectuiv(primitivesQuery, GL_QUERY_RESULT, &lastPrimitives);
+			queryPending = false;
+		}
+	}
+	bool counting = !queryPending;
+	if (counting)
+		glBeginQuery(GL_PRIMITIVES_GENERATED, primitivesQuery);
+	DrawEarth(program, camera.modelview*m, dt);
+	if (counting) {
+		glEndQuery(GL_PRIMITIVES_GENERATED);
+		queryPending = true;
+	}
+	// light
+	glDisable(GL_DEPTH_TEST);
+	UseDrawShader(camera.fullview);
+	Disk(light, 12, vec3(1, 0, 0));
+	glFlush();
+}
+
+// mouse
+
+void MouseButton(GLFWwindow *w, int butn, int action, int mods) {
+	double x, y;
+	glfwGetCursorPos(w, &x, &y);
+	double yUp = winHeight-y; // upward-increasing screen space, for light picking; camera expects GLFW y
+	picked = NULL;
+	if (action == GLFW_RELEASE)
+		camera.MouseUp();
+	if (action == GLFW_PRESS) {
+		if (MouseOver(x, yUp, light, camera.fullview)) {
+			mover.Down(&light, (int) x, (int) yUp, camera.modelview, camera.persp);
+			picked = &mover;
+		}
+		else {
+			picked = &camera;
+			camera.MouseDown((int) x, (int) y);
+		}
+	}
+}
+
+void MouseMove(GLFWwindow *w, double x, double y) {
+	if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
+		if (picked == &mover)
+			mover.Drag((int) x, (int) (winHeight-y), camera.modelview, camera.persp);
+		if (picked == &camera)
+			camera.MouseDrag((int) x, (int) y, Shift());
+	}
+}
+
+void MouseWheel(GLFWwindow *w, double ignore, double spin) {
+	camera.MouseWheel(spin > 0, Shift());
+}
+
+// keyboard
+
+void Keyboard(GLFWwindow *w, int key, int scancode, int action, int mods) {
+	if (action != GLFW_PRESS && action != GLFW_REPEAT)
+		return;
+	if (key == GLFW_KEY_EQUAL || key == GLFW_KEY_MINUS) {
+		pixelsPerEdge *= key == GLFW_KEY_EQUAL ? .8f : 1.25f;
+		pixelsPerEdge = pixelsPerEdge < 1 ? 1 : pixelsPerEdge > 200 ? 200 : pixelsPerEdge;
+	}
+	if (key == 'C')
+		cullPatches = !cullPatches;
+	if (key == GLFW_KEY_EQUAL || key == GLFW_KEY_MINUS || key == 'C' || key == 'T')
+		printf("%.1f pixels per edge, culling %s: %u triangles\n", pixelsPerEdge, cullPatches ? "on" : "off", lastPrimitives);
+}
+
+// application
+
+void Resize(GLFWwindow *window, int width, int height) {
+	camera.Resize(winWidth = width, winHeight = height);
+	glViewport(0, 0, width, height);
+}
+
+const char* credit = "\
+	Created by Justin Thoreson\n\
+-------------------------------------------------------\n\
+";
+
+const char* usage = "\n\
+                 DRAG RED DOT: move light source\n\
+            LEFT-CLICK + DRAG: rotate view\n\
+    SHIFT + LEFT-CLICK + DRAG: move objects\n\
+                       SCROLL: rotate view\n\
+               SHIFT + SCROLL: zoom in and out\n\
+                        + & -: finer/coarser tessellation\n\
+                            C: toggle patch culling\n\
+                            T: print triangles last frame\n\
+\n\
+    -virtual [file.vt] -budget MB: stream Earth as tiles\n\
+           -grid columns image...: build file.vt from a grid of images\n\
+";
+
+int main(int ac, char **av) {
+	for (int i = 1; i < ac; i++) {
+		if (!strcmp(av[i], "-virtual")) {
+			virtualOn = true;
+			if (i+1 < ac && av[i+1][0] != '-')
+				virtualFilename = av[++i];
+		}
+		if (!strcmp(av[i], "-budget") && i+1 < ac)
+			virtualBudget = atoi(av[++i]);
+		if (!strcmp(av[i], "-grid") && i+1 < ac) {
+			virtualColumns = atoi(av[++i]);
+			while (i+1 < ac && av[i+1][0] != '-')
+				virtualSources.push_back(av[++i]);
+		}
+	}
+	// init app window
+	if (!glfwInit())
+		return 1;
+	glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
+	GLFWwindow *w = glfwCreateWindow(winWidth, winHeight, "Earth Tessellation", NULL, NULL);
+	glfwSetWindowPos(w, 100, 100);
+	glfwMakeContextCurrent(w);
+	// init OpenGL, shader program, texture
+	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+	GLCountInstall(); // count GL calls per frame
+	EnableParallelShaderCompile((GLADloadproc) glfwGetProcAddress);
+	if (virtualOn) {
+		FILE *f = fopen(virtualFilename, "rb");
+		if (f)
+			fclose(f);
+		else if (virtualSources.empty() ? !BuildVirtualTexture(textureFilename, virtualFilename) :
+				!BuildVirtualTexture(virtualSources, virtualColumns, virtualFilename))
+			printf("can't build %s from %s\n", virtualFilename, virtualSources.empty() ? textureFilename : "grid");
+		virtualOn = virtualTexture.Init(virtualFilename, virtualBudget);
+	}
+	const char **pCode = virtualOn ? &pVirtualCode : &pShaderCode;
+	program = LinkProgramCachedAsync(&vShaderCode, &tcShaderCode, &teShaderCode, NULL, pCode); // awaited in Display
+	if (virtualOn)
+		feedbackProgram = LinkProgramCachedAsync(&vShaderCode, &tcShaderCode, &teShaderCode, NULL, &pFeedbackCode);
+	glGenQueries(1, &primitivesQuery);
+	textureLoader.Init();
+	if (!virtualOn)
+		textureName = textureLoader.Load(textureFilename, textureUnit, true); // BC1, prebuilt mips; placeholder until uploaded
+	// callbacks
+	glfwSetCursorPosCallback(w, MouseMove);
+	glfwSetMouseButtonCallback(w, MouseButton);
+	glfwSetScrollCallback(w, MouseWheel);
+	glfwSetWindowSizeCallback(w, Resize);
+	glfwSetKeyCallback(w, Keyboard);
+	printf("\n%s\n", credit);
+	printf("Usage:\n%s\n", usage);
+	// event loop
+	glfwSwapInterval(1);
+	while (!glfwWindowShouldClose(w)) {
+		textureLoader.Update();
+		Display();
+		GLCountNewFrame();
+		glfwPollEvents();
+		glfwSwapBuffers(w);
+	}
+	textureLoader.Release();
+	glDeleteQueries(1, &primitivesQuery);
+	printf("EarthTess: %.1f pixels per edge, %u triangles last counted\n", pixelsPerEdge, lastPrimitives);
+	if (virtualOn) {
+		virtualTexture.PrintStats("EarthTess");
+		virtualTexture.Release();
+	}
+	PrintProgramCacheStats("EarthTess"); // cold (compiled) vs warm (cached) startup
+	PrintTextureCacheStats("EarthTess");
+	GLCountPrint("EarthTess");
+	glfwDestroyWindow(w);
+	glfwTerminate();
+}
@@ -1,245 +1,425 @@
-// MushroomEarth.cpp
-// (c) Justin Thoreson
-// 21 October 2021
-// Earth is not flat
-
-#include <glad.h>
-#include <glfw3.h>
-#include <stdio.h>
-#include <VecMat.h>
-#include <vector>
-#include "GLXtras.h"
-#include "Mesh.h"
-#include "Camera.h"
-#include "Misc.h"
-
-// GPU identifiers
-GLuint program = 0, vBuffer = 0, texUnit = 0, texName; 
-
-const char* objFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Objects/Mushroom.obj";
-const char* texFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/Earth.jpg";
-std::vector<vec3> points;
-std::vector<vec3> normals;
-std::vector<vec2> textures;
-std::vector<int3> triangles;
-
-int winW = 750, winH = 750;
-Camera camera((float) winW/winH, vec3(0, 0, 0), vec3(0, 0, -10));
-
-// Shaders 
-
-const char* vertexShader = R"(
-    #version 130
-    in vec2 uv;
-    in vec3 point, normal;
-    out vec2 vUv; 
-    out vec3 vPoint, vNormal; 
-    uniform mat4 modelview, persp; 
-    uniform int freq = 1;
-    void main() { 
-        vPoint = (modelview*vec4(point, 1)).xyz; 
-        vNormal = (modelview*vec4(normal, 0)).xyz; 
-        gl_Position = persp*vec4(vPoint, 1);
-        vUv = freq * uv;
-    } 
-)";
-
-const char *pixelShader = R"(
-    #version 130
-    in vec2 vUv;
-    in vec3 vPoint, vNormal;
-    out vec4 pColor;
-    uniform sampler2D texImage;
-    uniform vec3 lightPos = vec3(1,0,0);     // light location
-    uniform vec3 color;                      // default color
-    uniform float amb = .05;                 // ambient coeff
-    uniform float dif = .7;                  // diffuse coeff
-    uniform float spc = .5;                  // specular coeff
-    void main() {
-        vec3 N = normalize(vNormal);         // surface normal
-        vec3 L = normalize(lightPos-vPoint); // light vector
-        vec3 E = normalize(vPoint);          // eye vector
-        vec3 R = reflect(L, N);              // highlight vector
-        float d = dif*max(0, dot(N, L));     // one-sided Lambert
-        float h = max(0, dot(R, E));         // highlight term
-        float s = spc*pow(h, 100);           // specular term
-        float inten = clamp(amb+d+s, 0, 1);  // intensity
-        //pColor = vec4(inten*color, 1);     // pixel shade
-        vec3 tColor = texture(texImage, vUv).rgb; 
-        pColor = color[0] == -1 ? vec4(inten*tColor,1) : vec4(inten*color,1);
-    }
-)";
-
-void InitVertexBuffer() {
-    // make GPU buffer for points & colors, set it active buffer
-    glGenBuffers(1, &vBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
-    // allocate buffer memory to hold vertex locations and colors
-    int sPnts = points.size() * sizeof(vec3), sTex = textures.size() * sizeof(vec2);
-    glBufferData(GL_ARRAY_BUFFER, 2*sPnts+sTex, NULL, GL_STATIC_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, &points[0]);
-    glBufferSubData(GL_ARRAY_BUFFER, sPnts, sPnts, &normals[0]);
-    glBufferSubData(GL_ARRAY_BUFFER, 2*sPnts, sTex, &textures[0]);
-}
-
-bool InitShader() {
-    program = LinkProgramViaCode(&vertexShader, &pixelShader);
-    if (!program)
-        printf("can't init shader program\n");
-    return program != 0;
-}
-
-// Interaction & transformations
-static float scalar = .3f;
-
-bool Shift(GLFWwindow* w) {
-    return glfwGetKey(w, GLFW_KEY_LEFT_SHIFT) ||
-           glfwGetKey(w, GLFW_KEY_RIGHT_SHIFT);
-}
-
-void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
-    // Called when mouse button pressed or released
-    if (action == GLFW_PRESS) {
-        // Save reference for MouseDrag
-        double x, y;
-        glfwGetCursorPos(w, &x, &y);
-        camera.MouseDown((int)x, (int)y);
-    }
-    if (action == GLFW_RELEASE) {
-        // Save reference rotation
-        camera.MouseUp();
-    }
-}
-
-void MouseMove(GLFWwindow* w, double x, double y) {
-    if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-        camera.MouseDrag((int)x, (int)y, Shift(w));
-    }
-}
-
-void MouseWheel(GLFWwindow* w, double ignore, double spin) {
-    camera.MouseWheel(spin > 0, Shift(w));
-}
-
-void Resize(GLFWwindow* w, int width, int height) {
-    camera.Resize(winW = width, winH = height);
-    glViewport(0, 0, winW, winH);
-}
-
-// Application
-
-time_t startTime = clock();
-
-void Display(GLFWwindow* w) {
-    // Clear background
-    glClearColor(0, 0, 0, 1);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glClear(GL_DEPTH_BUFFER_BIT);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    // Access GPU vertex buffer
-    glUseProgram(program);
-    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
-    glActiveTexture(GL_TEXTURE0 + texUnit);
-    glBindTexture(GL_TEXTURE_2D, texName);
-    // Associate position input to shader with position array in vertex buffer
-    VertexAttribPointer(program, "point", 3, 0, (void*) 0);
-    VertexAttribPointer(program, "normal", 3, 0, (void*) (points.size()*sizeof(vec3)));
-    VertexAttribPointer(program, "uv", 2, 0, (void*) (2*points.size()*sizeof(vec3)));
-    // Draw triangles using indexed vertices
-    float dt = (float)(clock() - startTime) / CLOCKS_PER_SEC;
-    // Center mushroom w/ Earth texture, frequency is 1
-    mat4 m = RotateY(10 * dt);
-    SetUniform(program, "color", vec3(-1));
-    SetUniform(program, "texImage", (int) texUnit);
-    SetUniform(program, "modelview", camera.modelview * m);
-    SetUniform(program, "persp", camera.persp);
-    SetUniform(program, "freq", 1);
-    glDrawElements(GL_TRIANGLES, 3*triangles.size(), GL_UNSIGNED_INT, &triangles[0]);
-    // Orbital mushroom w/ Earth texture, frequency is 4
-    m = RotateY(-90 * dt) * RotateZ(-180 -(90*dt)) * Translate(0, 0, 2.5f) * RotateY(90 * dt) * Scale(0.5);
-    SetUniform(program, "color", vec3(-1));
-    SetUniform(program, "texImage", (int)texUnit);
-    SetUniform(program, "modelview", camera.modelview * m);
-    SetUniform(program, "persp", camera.persp);
-    SetUniform(program, "freq", 4); 
-    glDrawElements(GL_TRIANGLES, 3 * triangles.size(), GL_UNSIGNED_INT, &triangles[0]);
-    // Orbital mushroom w/o texture
-    m = RotateY(-90 * dt) * RotateZ(-90 * dt) * Translate(0, 0, -2.5f) * RotateY(90 * dt) * Scale(0.5);
-    SetUniform(program, "color", vec3(0,1,0));
-    SetUniform(program, "texImage", (int)texUnit);
-    SetUniform(program, "modelview", camera.modelview * m);
-    SetUniform(program, "persp", camera.persp);
-    SetUniform(program, "freq", 1);
-    glDrawElements(GL_TRIANGLES, 3 * triangles.size(), GL_UNSIGNED_INT, &triangles[0]);
-    glFlush();
-}
-
-void ErrorGFLW(int id, const char *reason) {
-    printf("GFLW error %i: %s\n", id, reason);
-}
-
-void Close() {
-    // Unbind vertex buffer and free GPU memory
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &vBuffer);
-    glDeleteBuffers(1, &texName);
-}
-
-const char* credit = "\
-	Created by Justin Thoreson\n\
--------------------------------------------------------\n\
-";
-
-const char* usage = "\n\
-            LEFT-CLICK + DRAG: rotate view\n\
-    SHIFT + LEFT-CLICK + DRAG: move objects\n\
-                       SCROLL: rotate view\n\
-               SHIFT + SCROLL: zoom in and out\n\
-";
-
-int main() {
-    glfwSetErrorCallback(ErrorGFLW);
-    if (!glfwInit())
-        return 1;
-    glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
-    GLFWwindow *window = glfwCreateWindow(winW, winH, "Mushroom Earth", NULL, NULL);
-    if (!window) {
-        glfwTerminate();
-        return 1;
-    }
-    glfwMakeContextCurrent(window);
-    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
-    // Read obj file
-    if (!ReadAsciiObj((char*)objFilename, points, triangles, &normals, &textures)) {
-        printf("Failed to read object file\n");
-        getchar();
-    }
-    printf("%i vertices, %i triangles, %i normals, %i uvs\n", points.size(), triangles.size(), normals.size(), textures.size());
-    Normalize(points, .8f);
-    printf("GL version: %s\n", glGetString(GL_VERSION));
-    PrintGLErrors();
-    if (!InitShader())
-        return 0;
-    InitVertexBuffer();
-    // Set callbacks for device interaction
-    glfwSetMouseButtonCallback(window, MouseButton);
-    glfwSetCursorPosCallback(window, MouseMove);
-    glfwSetScrollCallback(window, MouseWheel);
-    glfwSetWindowSizeCallback(window, Resize);
-    printf("\n%s\n", credit);
-    printf("Usage:\n%s\n", usage);
-    glfwSwapInterval(1); // Ensure no generated frame backlog
-    // Init texture map
-    texName = LoadTexture((char*)texFilename, texUnit);
-    // Event loop
-    while (!glfwWindowShouldClose(window)) {
-        Display(window);
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-    }
-    Close();
-    glfwDestroyWindow(window);
-    glfwTerminate();
-}
+// MushroomEarth.cpp
+// (c) Justin Thoreson
+// 21 October 2021
+// Earth is not flat
+
+#include <glad.h>
+#include <glfw3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <VecMat.h>
+#include <vector>
+#include "GLXtras.h"
+#include "Mesh.h"
+#include "ArcCamera.h"
+#include "Frustum.h"
+#include "GLState.h"
+#include "Misc.h"
+#include "GLCount.h"
+#include "GPUTimer.h"
+#include "ProgramCache.h"
+#include "ShaderVariants.h"
+#include "TextureLoader.h"
+#include "VirtualTexture.h"
+
+// GPU identifiers
+GLuint program = 0, vBuffer = 0, texUnit = 0, texName; // program is the bound variant
+
+const char* objFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Objects/Mushroom.obj";
+const char* texFilename = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/Earth.jpg";
+std::vector<vec3> points;
+std::vector<vec3> normals;
+std::vector<vec2> textures;
+std::vector<int3> triangles;
+Sphere meshBounds;                  // set after Normalize
+Frustum frustum;
+GLState glState;                    // filters redundant state changes and uniform writes
+TextureLoader textureLoader;        // Earth loaded by workers, uploaded in slices per frame
+
+// Sampling of the Earth texture, cycled by M; the small orbiter (freq 4) minifies heavily
+const char *samplingNames[] = { "bilinear, no mips", "trilinear", "trilinear, 8x anisotropic" };
+TextureSampling samplings[] = { TextureSampling(false, 1), TextureSampling(true, 1), TextureSampling(true, 8) };
+int sampling = 2;
+GPUTimer drawTimer;                 // GPU time of the mushroom draws, per sampling
+bool textureLoaded = false;         // sampling reapplied, timer restarted, once the loader finishes
+
+// Virtual texture (-virtual [file.vt] [-budget MB] [-grid columns image...]): tiles streamed by feedback
+bool virtualOn = false;
+const char *virtualFilename = "Earth.vt"; // built from texFilename if missing
+int virtualBudget = 64;                   // MB of atlas
+std::vector<std::string> virtualSources;  // -grid columns image...: row-major tiles of imagery, built into the file
+int virtualColumns = 1;
+VirtualTexture virtualTexture;
+unsigned int passKey = 0;                 // VIRTUAL, plus FEEDBACK during the feedback pass
+
+int winW = 750, winH = 750;
+ArcCamera camera(winW, winH, vec3(0, 0, 0), vec3(0, 0, -10));
+int viewChanges = -1; // camera.Changes() when frustum last set
+
+// Shaders 
+
+const char* vertexShader = R"(
+    #version 130
+    in vec2 uv;
+    in vec3 point, normal;
+    out vec2 vUv; 
+    out vec3 vPoint, vNormal; 
+    uniform mat4 modelview, persp; 
+    uniform int freq = 1;
+    void main() { 
+        vPoint = (modelview*vec4(point, 1)).xyz; 
+        vNormal = (modelview*vec4(normal, 0)).xyz; 
+        gl_Position = persp*vec4(vPoint, 1);
+        vUv = freq * uv;
+    } 
+)";
+
+const char *pixelShader = R"(
+    #version 130
+    in vec2 vUv;
+    in vec3 vPoint, vNormal;
+#ifdef FEEDBACK
+    out uvec4 pFeedback;
+#else
+    out vec4 pColor;
+#endif
+#ifdef VIRTUAL
+)" VT_LOOKUP VT_FEEDBACK R"(
+#endif
+#ifdef TEXTURE
+    uniform sampler2D texImage;
+#else
+    uniform vec3 color;                      // default color
+#endif
+    uniform vec3 lightPos = vec3(1,0,0);     // light location
+    uniform float amb = .05;                 // ambient coeff
+    uniform float dif = .7;                  // diffuse coeff
+    uniform float spc = .5;                  // specular coeff
+    void main() {
+#ifdef FEEDBACK
+        pFeedback = VirtualFeedback(vUv);    // page wanted here
+#else
+        vec3 N = normalize(vNormal);         // surface normal
+        vec3 L = normalize(lightPos-vPoint); // light vector
+        vec3 E = normalize(vPoint);          // eye vector
+        vec3 R = reflect(L, N);              // highlight vector
+        float d = dif*max(0, dot(N, L));     // one-sided Lambert
+        float h = max(0, dot(R, E));         // highlight term
+        float s = spc*pow(h, 100);           // specular term
+        float inten = clamp(amb+d+s, 0, 1);  // intensity
+#if defined(VIRTUAL)
+        vec3 tColor = VirtualTexture(vUv).rgb;
+        pColor = vec4(inten*tColor, 1);
+#elif defined(TEXTURE)
+        vec3 tColor = texture(texImage, vUv).rgb;
+        pColor = vec4(inten*tColor, 1);
+#else
+        pColor = vec4(inten*color, 1);       // pixel shade
+#endif
+#endif
+    }
+)";
+
+void InitVertexBuffer() {
+    // make GPU buffer for points & colors, set it active buffer
+    glGenBuffers(1, &vBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
+    // allocate buffer memory to hold vertex locations and colors
+    int sPnts = points.size() * sizeof(vec3), sTex = textures.size() * sizeof(vec2);
+    glBufferData(GL_ARRAY_BUFFER, 2*sPnts+sTex, NULL, GL_STATIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, &points[0]);
+    glBufferSubData(GL_ARRAY_BUFFER, sPnts, sPnts, &normals[0]);
+    glBufferSubData(GL_ARRAY_BUFFER, 2*sPnts, sTex, &textures[0]);
+}
+
+// Shader variants: textured or flat colored; texture virtual, or its feedback
+const unsigned int TEXTURE = 1, VIRTUAL = 2, FEEDBACK = 4;
+ShaderVariants shaders(vertexShader, pixelShader, { "TEXTURE", "VIRTUAL", "FEEDBACK" });
+
+void InitShader() {
+    // Start links; Display waits on each at first use
+    EnableParallelShaderCompile((GLADloadproc) glfwGetProcAddress);
+    shaders.Prepare(TEXTURE | passKey);
+    if (virtualOn)
+        shaders.Prepare(TEXTURE | VIRTUAL | FEEDBACK);
+    shaders.Prepare(0);
+}
+
+// Interaction & transformations
+static float scalar = .3f;
+
+bool Shift(GLFWwindow* w) {
+    return glfwGetKey(w, GLFW_KEY_LEFT_SHIFT) ||
+           glfwGetKey(w, GLFW_KEY_RIGHT_SHIFT);
+}
+
+void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
+    // Called when mouse button pressed or released
+    if (action == GLFW_PRESS) {
+        // Save reference for MouseDrag
+        double x, y;
+        glfwGetCursorPos(w, &x, &y);
+        camera.MouseDown((int)x, (int)y);
+    }
+    if (action == GLFW_RELEASE) {
+        // Save reference rotation
+        camera.MouseUp();
+    }
+}
+
+void MouseMove(GLFWwindow* w, double x, double y) {
+    if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
+        camera.MouseDrag((int)x, (int)y, Shift(w));
+    }
+}
+
+void MouseWheel(GLFWwindow* w, double ignore, double spin) {
+    camera.MouseWheel(spin > 0, Shift(w));
+}
+
+void ApplySampling() {
+    // Current policy on the Earth texture; GPU times restart, as they are per policy
+    glActiveTexture(GL_TEXTURE0 + texUnit);
+    glBindTexture(GL_TEXTURE_2D, texName);
+    SetTextureSampling(GL_TEXTURE_2D, samplings[sampling]);
+    glState.InvalidateTextures();
+    drawTimer.Reset();
+}
+
+void Keyboard(GLFWwindow* w, int key, int scancode, int action, int mods) {
+    if (action == GLFW_PRESS) {
+        if (key == GLFW_KEY_ESCAPE)
+            glfwSetWindowShouldClose(w, GLFW_TRUE);
+        // Toggle frustum culling
+        if (key == GLFW_KEY_C) {
+            frustum.enabled = !frustum.enabled;
+            printf("Culling %s\n", frustum.enabled ? "enabled" : "disabled");
+            frustum.PrintStats("Last frame");
+        }
+        // Cycle texture sampling, reporting GPU draw time of the previous
+        if (key == GLFW_KEY_M && texName) {
+            printf("%s: %.2f ms GPU over %i frames\n", samplingNames[sampling], drawTimer.Average(), drawTimer.Frames());
+            sampling = (sampling + 1) % 3;
+            ApplySampling();
+            printf("sampling: %s (anisotropy up to %g)\n", samplingNames[sampling], MaxTextureAnisotropy());
+        }
+        // Print GL calls of last frame
+        if (key == GLFW_KEY_G) {
+            glState.PrintStats("Last frame");
+            GLCountPrint("MushroomEarth");
+        }
+    }
+}
+
+void Resize(GLFWwindow* w, int width, int height) {
+    camera.Resize(winW = width, winH = height);
+    glViewport(0, 0, winW, winH);
+}
+
+// Application
+
+time_t startTime = clock();
+
+void UseVariant(unsigned int key) {
+    // Bind variant; its attributes and per-frame uniforms are set on each switch
+    GLuint p = shaders.Program(key);
+    if (p == program)
+        return;
+    glState.UseProgram(program = p);
+    // Associate position input to shader with position array in vertex buffer
+    VertexAttribPointer(program, "point", 3, 0, (void*) 0);
+    if (!(key & FEEDBACK))      // feedback shades nothing: normal is compiled out
+        VertexAttribPointer(program, "normal", 3, 0, (void*) (points.size()*sizeof(vec3)));
+    VertexAttribPointer(program, "uv", 2, 0, (void*) (2*points.size()*sizeof(vec3)));
+    glState.SetUniform(program, "persp", camera.persp);
+    if (key & VIRTUAL) {
+        virtualTexture.Use(program, (key & FEEDBACK) != 0);
+        glState.InvalidateTextures();
+    }
+    else if (key & TEXTURE)
+        glState.SetUniform(program, "texImage", (int) texUnit);
+}
+
+void DrawMushroom(mat4 m, vec3 color, int freq) {
+    // Skip if outside view, color of -1 uses texture
+    if (!frustum.Visible(m, meshBounds))
+        return;
+    bool textured = color[0] == -1;
+    if (!textured && (passKey & FEEDBACK))
+        return;                     // only textured surfaces request pages
+    UseVariant(textured ? TEXTURE | passKey : 0);
+    if (!textured)
+        glState.SetUniform(program, "color", color);
+    glState.SetUniform(program, "modelview", camera.modelview * m);
+    glState.SetUniform(program, "freq", freq);
+    glDrawElements(GL_TRIANGLES, 3 * triangles.size(), GL_UNSIGNED_INT, &triangles[0]);
+}
+
+void DrawMushrooms(float dt) {
+    // Center mushroom w/ Earth texture, frequency is 1
+    DrawMushroom(RotateY(10 * dt), vec3(-1), 1);
+    // Orbital mushroom w/ Earth texture, frequency is 4
+    DrawMushroom(RotateY(-90 * dt) * RotateZ(-180 -(90*dt)) * Translate(0, 0, 2.5f) * RotateY(90 * dt) * Scale(0.5), vec3(-1), 4);
+    // Orbital mushroom w/o texture
+    DrawMushroom(RotateY(-90 * dt) * RotateZ(-90 * dt) * Translate(0, 0, -2.5f) * RotateY(90 * dt) * Scale(0.5), vec3(0, 1, 0), 1);
+}
+
+void Display(GLFWwindow* w) {
+    glState.NewFrame();
+    float dt = (float)(clock() - startTime) / CLOCKS_PER_SEC;
+    if (camera.Changed(viewChanges))
+        frustum.Set(camera.fullview);
+    frustum.ResetStats();
+    if (virtualOn) {
+        // Pages wanted this frame, read back next frame
+        virtualTexture.Update();
+        glState.InvalidateTextures();
+        glState.Enable(GL_DEPTH_TEST);
+        glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer);
+        virtualTexture.BeginFeedback(winW, winH);
+        passKey = VIRTUAL | FEEDBACK;
+        program = 0;
+        DrawMushrooms(dt);
+        passKey = VIRTUAL;
+        virtualTexture.EndFeedback();
+        frustum.ResetStats();
+    }
+    // Clear background
+    glClearColor(0, 0, 0, 1);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glState.Enable(GL_DEPTH_TEST);
+    glState.Enable(GL_BLEND);
+    glState.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Access GPU vertex buffer
+    glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer);
+    glState.BindTexture(texUnit, GL_TEXTURE_2D, texName);
+    program = 0; // rebind first variant drawn, setting its attributes
+    // Draw triangles using indexed vertices
+    drawTimer.Begin();
+    DrawMushrooms(dt);
+    drawTimer.End();
+    glFlush();
+}
+
+void ErrorGFLW(int id, const char *reason) {
+    printf("GFLW error %i: %s\n", id, reason);
+}
+
+void Close() {
+    // Unbind vertex buffer and free GPU memory
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &vBuffer);
+    glDeleteBuffers(1, &texName);
+    textureLoader.Release();
+    printf("%s: %.2f ms GPU over %i frames\n", samplingNames[sampling], drawTimer.Average(), drawTimer.Frames());
+    drawTimer.Release();
+    if (virtualOn) {
+        virtualTexture.PrintStats("MushroomEarth");
+        virtualTexture.Release();
+    }
+}
+
+const char* credit = "\
+	Created by Justin Thoreson\n\
+-------------------------------------------------------\n\
+";
+
+const char* usage = "\n\
+            LEFT-CLICK + DRAG: rotate view\n\
+    SHIFT + LEFT-CLICK + DRAG: move objects\n\
+                       SCROLL: rotate view\n\
+               SHIFT + SCROLL: zoom in and out\n\
+                            C: toggle frustum culling\n\
+                            G: print GL calls issued/elided\n\
+                            M: cycle texture sampling, print GPU draw time\n\
+\n\
+    -virtual [file.vt] -budget MB: stream Earth as tiles\n\
+           -grid columns image...: build file.vt from a grid of images\n\
+";
+
+int main(int ac, char **av) {
+    for (int i = 1; i < ac; i++) {
+        if (!strcmp(av[i], "-virtual")) {
+            virtualOn = true;
+            if (i+1 < ac && av[i+1][0] != '-')
+                virtualFilename = av[++i];
+        }
+        if (!strcmp(av[i], "-budget") && i+1 < ac)
+            virtualBudget = atoi(av[++i]);
+        if (!strcmp(av[i], "-grid") && i+1 < ac) {
+            virtualColumns = atoi(av[++i]);
+            while (i+1 < ac && av[i+1][0] != '-')
+                virtualSources.push_back(av[++i]);
+        }
+    }
+    passKey = virtualOn ? VIRTUAL : 0;
+    glfwSetErrorCallback(ErrorGFLW);
+    if (!glfwInit())
+        return 1;
+    glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
+    GLFWwindow *window = glfwCreateWindow(winW, winH, "Mushroom Earth", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    GLCountInstall(); // count GL calls per frame
+    InitShader();     // compiles while mesh and texture load
+    // Read obj file
+    if (!ReadAsciiObj((char*)objFilename, points, triangles, &normals, &textures)) {
+        printf("Failed to read object file\n");
+        getchar();
+    }
+    printf("%i vertices, %i triangles, %i normals, %i uvs\n", points.size(), triangles.size(), normals.size(), textures.size());
+    Normalize(points, .8f);
+    meshBounds = BoundingSphere(points);
+    printf("GL version: %s\n", glGetString(GL_VERSION));
+    PrintGLErrors();
+    InitVertexBuffer();
+    // Set callbacks for device interaction
+    glfwSetMouseButtonCallback(window, MouseButton);
+    glfwSetCursorPosCallback(window, MouseMove);
+    glfwSetScrollCallback(window, MouseWheel);
+    glfwSetWindowSizeCallback(window, Resize);
+    glfwSetKeyCallback(window, Keyboard);
+    printf("\n%s\n", credit);
+    printf("Usage:\n%s\n", usage);
+    glfwSwapInterval(1); // Ensure no generated frame backlog
+    // Init texture map
+    textureLoader.Init();
+    if (virtualOn) {
+        FILE *f = fopen(virtualFilename, "rb");
+        if (f)
+            fclose(f);
+        else if (virtualSources.empty() ? !BuildVirtualTexture(texFilename, virtualFilename) :
+                !BuildVirtualTexture(virtualSources, virtualColumns, virtualFilename))
+            printf("can't build %s from %s\n", virtualFilename, virtualSources.empty() ? texFilename : "grid");
+        virtualOn = virtualTexture.Init(virtualFilename, virtualBudget);
+        passKey = virtualOn ? VIRTUAL : 0;
+        glState.InvalidateTextures();
+    }
+    if (!virtualOn)
+        texName = textureLoader.Load(texFilename, texUnit, true, vec3(.5f, .5f, .5f), samplings[sampling]); // BC1, prebuilt mips; placeholder until uploaded
+    // Event loop
+    while (!glfwWindowShouldClose(window)) {
+        if (textureLoader.Update()) {
+            glState.InvalidateTextures();
+            if (texName && !textureLoaded && !textureLoader.Loading(texName)) {
+                textureLoaded = true;
+                ApplySampling(); // an upload mid-comparison can't leave another policy set, or time the placeholder
+            }
+        }
+        Display(window);
+        GLCountNewFrame();
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+    Close();
+    PrintProgramCacheStats("MushroomEarth"); // cold (compiled) vs warm (cached) startup
+    PrintTextureCacheStats("MushroomEarth");
+    GLCountPrint("MushroomEarth");
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
@@ -1,495 +1,1142 @@
-// PortalIllusion.cpp (Portalv4.0)
-// (c) Justin Thoreson
-// 11 December 2021
-
-#define _USE_MATH_DEFINES
-
-#include <glad.h>
-#include <glfw3.h>
-#include <stdio.h>
-#include <vector>
-#include "VecMat.h"
-#include "Camera.h"
-#include "Draw.h"
-#include "GLXtras.h"
-#include "time.h"
-#include "Misc.h"
-// Multimedia for audio
-#include <mmsystem.h>
-#pragma comment(lib, "winmm.lib")
-
-// GPU Identifiers
-GLuint vBuffer = 0, cubeProgram = 0;
-GLuint heartFireTexUnit = 0, companionCubeTexUnit = 1, heartFireTexName, companionCubeTexName;
-
-// Textures
-const char* heartFireTexFileName = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/HeartFire.jpg";
-const char* companionCubeTexFileName = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/CompanionCube.png";
-
-// Camera
-int windowWidth = 750, windowHeight = 750;
-float fieldOfView = 40;
-Camera camera(windowWidth, windowHeight, vec3(0, 0, 0), vec3(0, 0, -10), fieldOfView);
-
-// Cube Vertices
-float l = -1, r = 1, b = -1, t = 1, n = -1, f = 1; // left, right, bottom, top, near, far
-vec3 vertices[] = { {l,b,n}, {l,b,f}, {l,t,n}, {l,t,f}, {r,b,n}, {r,b,f}, {r,t,n}, {r,t,f} };
-vec3 colors[] = { {1,0,0}, {1,0,0}, {1,1,0}, {1,1,0}, {1,0,1}, {1,0,1}, {0,1,1}, {0,1,1} };
-vec3 normals[] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} };
-vec2 texs[] = { {0,0}, {1,0}, {1,1}, {0,1} };
-
-// Cube Faces
-int quads[][4] = {	// ccw order
-	{ 0, 2, 3, 1 },	// left face
-	{ 4, 5, 7, 6 },	// right
-	{ 0, 1, 5, 4 },	// bottom
-	{ 2, 6, 7, 3 },	// top
-	{ 0, 4, 6, 2 },	// near
-	{ 1, 3, 7, 5 }	// far
-};
-
-// Particles
-const float H_VARIANCE = 0.005f;
-const float LIFE_DT = 0.0075f;
-float rand_float(float min = 0, float max = 1) { return min + (float)rand() / (RAND_MAX / (max - min)); }
-
-struct Particle {
-	vec3 pos, vel;
-	vec3 baseColor;
-	vec3 currentColor;
-	float life;
-	Particle() {
-		pos = vec3(0.0f), vel = vec3(0.0f), baseColor = currentColor = vec3(1.0f), life = 0.0f;
-	}
-	void Revive(vec3 new_pos = vec3(0.0f, 0.0f, 0.0f)) {
-		life = 1.0f;
-		pos = new_pos;
-		vel = vec3(rand_float(-H_VARIANCE, H_VARIANCE), rand_float(0.001f, 0.0025f), rand_float(-H_VARIANCE, H_VARIANCE));
-	}
-	void Run() {
-		if (life > 0.0f) {
-			life -= LIFE_DT;
-			pos += vel;
-			currentColor = vec3(0, 1 - life, 0) + baseColor;
-		}
-	}
-};
-int numParticles = 250;
-std::vector<Particle> particles = std::vector<Particle>();
-
-// Interaction
-
-time_t startTime = clock();
-static float cubePosition;
-static float scalar = .3f;
-static bool particlesOn = false, musicOn = false, shaded = true, companionCubeTextured = false, oscillate = false;
-
-// Initialization
-
-void InitVertexBuffer() {
-	// Set duplicated points
-	vec3 pnts[24], nrms[24], cols[24];
-	vec2 uvs[24];
-	for (int f = 0; f < 6; f++) {	    // Each face of cube 
-		for (int k = 0; k < 4; k++) {	// Each corner of face
-			int vid = quads[f][k], count = 4 * f + k;
-			pnts[count] = vertices[vid];
-			cols[count] = colors[vid];
-			nrms[count] = normals[f];
-			uvs[count] = texs[k];
-		}
-	}
-	// Make GPU buffer, set it active
-	glGenBuffers(1, &vBuffer);
-	glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
-	// Allocate buffer memory to hold vertex locations and colors
-	int sPnts = sizeof(pnts), sCols = sizeof(cols), sNrms = sizeof(nrms), sUvs = sizeof(uvs);
-	glBufferData(GL_ARRAY_BUFFER, sPnts+sCols+sNrms+sUvs, NULL, GL_STATIC_DRAW);
-	// Load data to the GPU
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, pnts);
-	glBufferSubData(GL_ARRAY_BUFFER, sPnts, sCols, cols);
-	glBufferSubData(GL_ARRAY_BUFFER, sPnts+sCols, sNrms, nrms);
-	glBufferSubData(GL_ARRAY_BUFFER, sPnts+sCols+sNrms, sUvs, uvs);
-}
-
-// Shaders
-
-const char *vertexCubeShader = R"(
-	#version 130
-	in vec3 point, color, normal;
-	in vec2 uv;
-	out vec3 vPoint, vColor, vNormal;
-	out vec2 vUv;
-	uniform mat4 modelview, persp;
-	void main() {
-		vPoint = (modelview*vec4(point, 1)).xyz;
-		vNormal = (modelview*vec4(normal, 0)).xyz;
-		gl_Position = persp*vec4(vPoint, 1);
-		vColor = color;
-		vUv = uv;
-	}
-)";
-
-const char *pixelCubeShader = R"(
-	#version 130
-	in vec2 vUv;
-	in vec3 vPoint, vColor, vNormal;
-	out vec4 pColor;
-	uniform sampler2D textureImage;
-	uniform bool useFlatColor = false, useTexture = false, useNormal = false, useUnifNorm = false; 
-	uniform vec3 flatColor;
-	uniform vec3 unifNorm;							 // normal set by uniform	
-	uniform vec3 lights[20];                         // max # lights is 20
-	uniform int nlights = 0;
-	float Intensity(vec3 normalV, vec3 eyeV, vec3 point, vec3 light) {
-		vec3 lightV = normalize(light-point);        // light vector
-		vec3 reflectV = reflect(lightV, normalV);    // highlight vector
-		float d = max(0, dot(normalV, lightV));      // one-sided diffuse
-		float s = max(0, dot(reflectV, eyeV));       // one-sided specular
-		return clamp(d+pow(s, 50), 0, 1);
-	}
-	void main() {
-		vec3 texColor = texture(textureImage, vUv).rgb;				
-		vec3 useColor = useTexture ? texColor : vColor;				
-		pColor = vec4(useFlatColor ? flatColor : useColor, 1);
-		if (useNormal) {
-			vec3 N = normalize(useUnifNorm ? unifNorm : vNormal);             // surface normal
-			vec3 E = normalize(vPoint);              // eye vector
-			float intensity = 0;
-			for (int i = 0; i < nlights; i++)
-				intensity += Intensity(N, E, vPoint, lights[i]);
-			intensity = clamp(intensity, 0, 1);
-			pColor.rgb *= intensity;
-		}
-	}
-)";
-
-// Display
-
-void ActivateTextures() {
-	glActiveTexture(GL_TEXTURE0 + heartFireTexUnit);
-	glBindTexture(GL_TEXTURE_2D, heartFireTexName);
-	glActiveTexture(GL_TEXTURE0 + companionCubeTexUnit);
-	glBindTexture(GL_TEXTURE_2D, companionCubeTexName);
-}
-
-void AccessAttributes() {
-	int sVrts = 24 * sizeof(vec3);
-	VertexAttribPointer(cubeProgram, "point", 3, 0, (void*)0);
-	VertexAttribPointer(cubeProgram, "color", 3, 0, (void*)sVrts);
-	VertexAttribPointer(cubeProgram, "normal", 3, 0, (void*)(2 * sVrts));
-	VertexAttribPointer(cubeProgram, "uv", 2, 0, (void*)(3 * sVrts));
-}
-
-void AnimateDrawParticles(mat4 tran, vec3 color) {
-	for (int i = 0; i < numParticles; i++) {
-		if (particles[i].life > 0.0f) {
-			particles[i].baseColor = color;
-			particles[i].Run();
-			vec4 res = tran * vec4(particles[i].pos, 1);
-			Disk(vec3(res.x, res.y, res.z), 10, particles[i].currentColor);
-		}
-	}
-}
-
-void ComputeNormals() {
-	for (int i = 0; i < 6; i++) {
-		int* q = &quads[i][0];
-		vec3 p[] = { vertices[q[0]], vertices[q[1]], vertices[q[2]] };
-		vec3 n = cross(p[1] - p[0], p[2] - p[1]);
-		SetUniform(cubeProgram, "unifNorm", n);
-	}
-}
-
-void ShadeCube(bool faceted, bool textured, mat4 m, vec3 color = vec3(1)) {
-	SetUniform(cubeProgram, "modelview", m);
-	SetUniform(cubeProgram, "useTexture", textured);
-	if (!faceted) {
-		SetUniform(cubeProgram, "useFlatColor", true);
-		SetUniform(cubeProgram, "useNormal", false);
-		SetUniform(cubeProgram, "flatColor", color);
-	}
-	if (faceted || textured) {
-		SetUniform(cubeProgram, "useFlatColor", false);
-		SetUniform(cubeProgram, "useUnifNorm", true);
-	}
-	if (faceted) {
-		SetUniform(cubeProgram, "useNormal", shaded);
-		ComputeNormals();
-	}
-	glDrawArrays(GL_QUADS, 0, 24);
-}
-
-void Display(GLFWwindow *w) {
-	// Clear background
-	glClearColor(0, 0, 0, 1);
-	glClear(GL_COLOR_BUFFER_BIT);
-	glClear(GL_DEPTH_BUFFER_BIT);
-	glEnable(GL_DEPTH_TEST);
-	// Init shader program, set vertex pull for points and colors
-	glBindBuffer(GL_ARRAY_BUFFER, vBuffer); 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glUseProgram(cubeProgram);
-	ActivateTextures();
-	AccessAttributes();
-	// Portal positions
-	float dt = (float)(clock() - startTime) / CLOCKS_PER_SEC;
-	mat4 persp = camera.persp;
-	mat4 m1 = Translate(3.25f, 0, 0) * Scale(1.25f, 1.5, 1), m2 = Translate(-3.25f, 0, 0) * Scale(1.25f, 1.5, 1);
-	mat4 m3 = Translate(0, (2.5f + 0.25f * cos(1.5f * dt)), -3.f) * RotateY(180) * Scale(1.5f, 1.5f, 0.005f);
-	mat4 m4 = RotateX(30 * dt) * RotateX(45) * RotateY(45) * Scale(.2f);
-	mat4 mOsc1 = Translate(0, cos(dt), 0), mOsc2 = Translate(0, -cos(dt), 0); // Portal oscillations
-	mat4 p1 = Translate(2.f, 0, 0) * Scale(1.25f, 1, 1) * RotateZ(90), p2 = Translate(-2.f, 0, 0) * Scale(1.25f, 1, 1) * RotateZ(-90);
-	// Transform portal entrances, determine lights
-	vec4 e1 = m1 * vec4(-1, 0, 0, 1), e2 = m2 * vec4(1, 0, 0, 1);
-	vec3 entrance1(e1.x, e1.y, e1.z), entrance2(e2.x, e2.y, e2.z);   // Portal entrances
-	vec4 l1 = camera.modelview*vec4(entrance1, 1), l2 = camera.modelview*vec4(entrance2, 1);
-	vec3 lights[] = { vec3(l1.x, l1.y, l1.z), vec3(l2.x, l2.y, l2.z) };
-	const int NUM_LIGHTS = sizeof(lights) / sizeof(vec3);
-	// Start rendering objects
-	SetUniform(cubeProgram, "persp", persp);
-	SetUniform(cubeProgram, "lights", &lights[0]);
-	SetUniform(cubeProgram, "nlights", NUM_LIGHTS);
-	// Black cubes
-	ShadeCube(false, false, camera.modelview * (oscillate ? mOsc1 : mat4(1.f)) * m1, vec3(0, 0, 0));
-	ShadeCube(false, false, camera.modelview * (oscillate ? mOsc2 : mat4(1.f)) * m2, vec3(0, 0, 0));
-	// Textured album art cube
-	if (musicOn) {
-		SetUniform(cubeProgram, "textureImage", (int)heartFireTexUnit);
-		ShadeCube(false, true, camera.modelview * m3);
-	}
-	// Portal entrances (rings)
-	const int NUM_MINI_CUBES = 60;
-	for (int i = 1; i <= NUM_MINI_CUBES; i++) {
-		mat4 miniCubeTran = RotateX((float)i * 360 / NUM_MINI_CUBES) * Translate(0, 0, .5f) * Scale(.1f, .05f, .05f);
-		ShadeCube(false, false, camera.modelview * (oscillate ? mOsc1 : mat4(1.f)) * Translate(2.0f, 0, 0) * miniCubeTran, vec3(0, 0, 1));
-		ShadeCube(false, false, camera.modelview * (oscillate ? mOsc2 : mat4(1.f)) * Translate(-2.0f, 0, 0) * miniCubeTran, vec3(1, 0.5, 0));
-	}
-	// Portal cubes
-	cubePosition = 2 * cos(dt);
-	SetUniform(cubeProgram, "textureImage", (int)companionCubeTexUnit);
-	ShadeCube(true, companionCubeTextured, camera.modelview * Translate(-2 + cubePosition, 0, 0) * m4);
-	ShadeCube(true, companionCubeTextured, camera.modelview * Translate(2 + cubePosition, 0, 0) * m4);
-	// Particles
-	glDisable(GL_DEPTH_TEST);
-	UseDrawShader(camera.persp*camera.modelview);
-	AnimateDrawParticles(p1, vec3(0, 0, 1)); 
-	AnimateDrawParticles(p2, vec3(1, 0, 0));
-	glFlush();
-}
-
-// Particle
-
-const vec2 GRAVITY = vec2(0.0f, -0.00025f);
-const float PARTICLE_SIZE = 2.0f;
-const int NUM_PARTICLES_SPAWNED = 1;
-
-int lastUsedParticle = 0;
-bool spaceDown = false;
-
-int FindNextParticle() {
-	// Search for dead particle from last used particle
-	for (int i = lastUsedParticle; i < numParticles; i++) {
-		if (particles[i].life <= 0.0f) {
-			lastUsedParticle = i;
-			return i;
-		}
-	}
-	// Search linearly through rest of particles
-	for (int i = 0; i < lastUsedParticle; i++) {
-		if (particles[i].life <= 0.0f) {
-			lastUsedParticle = i;
-			return i;
-		}
-	}
-	// If no dead particles exist, simply take the first particle
-	lastUsedParticle = 0;
-	return 0;
-}
-
-void SpawnParticle(GLFWwindow* w) {
-	vec3 m = vec3(0, 0, 0);
-	for (int i = 0; i < NUM_PARTICLES_SPAWNED; i++) {
-		int p = FindNextParticle();
-		particles[p].Revive(m);
-	}
-}
-
-// User Callbacks
-
-void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
-	// Called when mouse button pressed or released
-	if (action == GLFW_PRESS) {
-		// Save reference for MouseDrag
-		double x, y;
-		glfwGetCursorPos(w, &x, &y);
-		camera.MouseDown((int)x, (int)y);
-	}
-	if (action == GLFW_RELEASE) {
-		// Save reference rotation
-		camera.MouseUp();
-	}
-}
-
-void MouseMove(GLFWwindow* w, double x, double y) {
-	if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
-		camera.MouseDrag((int)x, (int)y, Shift());
-}
-
-void MouseWheel(GLFWwindow* w, double ignore, double spin) {
-	camera.MouseWheel(spin > 0, Shift());
-}
-
-void Keyboard(GLFWwindow* w, int key, int scancode, int action, int mods) {
-	if (action == GLFW_PRESS) {
-		if (key == GLFW_KEY_ESCAPE)
-			glfwSetWindowShouldClose(w, GLFW_TRUE);
-		// Field of view
-		float fieldOfView = camera.GetFOV();
-		bool shift = mods & GLFW_MOD_SHIFT;
-		fieldOfView += key == 'F' ? shift ? -5 : 5 : 0;
-		fieldOfView = fieldOfView < 5 ? 5 : fieldOfView > 150 ? 150 : fieldOfView;
-		camera.SetFOV(fieldOfView);
-		// Toggle light, shaded cube
-		if (key == GLFW_KEY_L) {
-			shaded = !shaded;
-			printf("Shading %s\n", shaded ? "enabled" : "disabled");
-		}
-		// Toggle particles
-		if (key == GLFW_KEY_P) {
-			particlesOn = !particlesOn;
-			printf("Particles %s\n", particlesOn ? "enabled" : "disabled");
-		}
-		// Toggle music
-		if (key == GLFW_KEY_M) {
-			if (!musicOn) {
-				// Play audio. EXULGOR - Untitled 001
-				PlaySound(0, 0, 0);
-				PlaySound(TEXT("C:/Users/jdtii/ComputerGraphics/Assets/Audio/EXULGOR_Untitled001"), NULL, SND_FILENAME | SND_ASYNC | SND_LOOP);
-				printf("Playing: EXULGOR - Untitled 001\n");
-				musicOn = !musicOn;
-			}
-			else {
-				// Stop playing music
-				PlaySound(0, 0, 0);
-				printf("No music is playing\n");
-				musicOn = !musicOn;
-			}
-		}
-		// Toggle texture
-		if (key == GLFW_KEY_T) {
-			companionCubeTextured = !companionCubeTextured;
-			printf("Texture %s\n", companionCubeTextured ? "enabled" : "disabled");
-		}
-		// Toggle portal oscillation
-		if (key == GLFW_KEY_O) {
-			oscillate = !oscillate;
-			printf("Oscillation %s\n", oscillate ? "enabled" : "disabled");
-		}
-	}
-}
-
-// Credit & Usage
-
-const char* credit = "\n\
-	      Created by Justin Thoreson\n\
- Special thanks to Jules Bloomenthal & Devon McKee\n\n\
--------------------------------------------------------\n\
-";
-
-const char* usage = "\n\
-            LEFT-CLICK + DRAG: adjust view\n\
-    SHIFT + LEFT-CLICK + DRAG: move objects\n\
-                       SCROLL: rotate view\n\
-               SHIFT + SCROLL: zoom in and out\n\
-               F or SHIFT + F: adjust field of view\n\
-                            L: toggle lighting/shading\n\
-                            P: toggle particles\n\
-                            M: toggle music\n\
-                            T: toggle texture\n\
-                            O: toggle oscillation\n\n\
--------------------------------------------------------\n\
-";
-
-// Application
-
-void PrintProgramInfo() {
-	printf("GL version: %s\n\n", glGetString(GL_VERSION));
-	printf("Credit:\n%s\n", credit);
-	printf("Usage:\n%s\n", usage);
-	printf("Toggles:\n\n");
-}
-
-void Resize(GLFWwindow* w, int width, int height) {
-	camera.Resize(windowWidth = width, windowHeight = height);
-	glViewport(0, 0, windowWidth, windowHeight);
-}
-
-void InitCallbacks(GLFWwindow* w) {
-	glfwSetMouseButtonCallback(w, MouseButton);
-	glfwSetCursorPosCallback(w, MouseMove);
-	glfwSetScrollCallback(w, MouseWheel);
-	glfwSetWindowSizeCallback(w, Resize);
-	glfwSetKeyCallback(w, Keyboard);
-}
-
-void InitTextures() {
-	heartFireTexName = LoadTexture((char*)heartFireTexFileName, heartFireTexUnit);
-	companionCubeTexName = LoadTexture((char*)companionCubeTexFileName, companionCubeTexUnit);
-}
-
-void InitParticles() {
-	for (int i = 0; i < numParticles; i++)
-		particles.push_back(Particle());
-}
-
-void EmitParticles(GLFWwindow* w) {
-	bool thresholdCrossed = cubePosition < 0.5 && cubePosition > -0.5;
-	if (thresholdCrossed && particlesOn)
-		SpawnParticle(w);
-}
-
-void Close() {
-	// Unbind vertex buffer and free GPU memory
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glDeleteBuffers(1, &vBuffer);
-	glDeleteBuffers(1, &heartFireTexName);
-}
-
-int main() {
-	srand((int) time(NULL));
-	// Init GLFW library and create window
-	if (!glfwInit())
-		return 1;
-	glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
-	GLFWwindow *window = glfwCreateWindow(windowWidth, windowHeight, "Portal Illusion", NULL, NULL);
-	if (!window) {
-		glfwTerminate();
-		return 1;
-	}
-	glfwMakeContextCurrent(window);
-	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
-	PrintProgramInfo();
-	PrintGLErrors();
-	// Link shader program
-	cubeProgram = LinkProgramViaCode(&vertexCubeShader, &pixelCubeShader);
-	if (!cubeProgram)
-		printf("can't init shader program\n");
-	InitVertexBuffer();
-	InitParticles();       // Set particles
-	InitCallbacks(window); // Set callbacks for device interaction
-	glfwSwapInterval(1);   // Ensure no generated frame backlog
-	InitTextures();        // Set textures
-	// Event loop
-	while (!glfwWindowShouldClose(window)) {
-		Display(window);
-		EmitParticles(window);
-		glfwSwapBuffers(window);
-		glfwPollEvents();
-	}
-	// Terminate program, clean up
-	Close();
-	glfwDestroyWindow(window);
-	glfwTerminate();
-}
+// PortalIllusion.cpp (Portalv4.0)
+// (c) Justin Thoreson
+// 11 December 2021
+
+#define _USE_MATH_DEFINES
+
+#include <glad.h>
+#include <glfw3.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "VecMat.h"
+#include "ArcCamera.h"
+#include "Frustum.h"
+#include "StreamBuffer.h"
+#include "GLState.h"
+#include "Draw.h"
+#include "GLXtras.h"
+#include "time.h"
+#include "Misc.h"
+#include "GLCount.h"
+#include "ProgramCache.h"
+#include "ShaderVariants.h"
+#include "ShaderReload.h"
+#include "LightClusters.h"
+#include "DeferredShading.h"
+#include "PointShadows.h"
+#include "OcclusionQueries.h"
+#include "TextureLoader.h"
+// Multimedia for audio
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+
+// GPU Identifiers
+GLuint vBuffer = 0, cubeProgram = 0, particleProgram = 0; // cubeProgram is the bound cube variant
+StreamBuffer particleStream; // per-frame particle points and colors
+GLState glState;             // filters redundant state changes and uniform writes
+GLuint heartFireTexUnit = 0, companionCubeTexUnit = 1, heartFireTexName, companionCubeTexName;
+TextureLoader textureLoader; // placeholders until loaded by workers, uploaded in slices per frame
+
+// Textures
+const char* heartFireTexFileName = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/HeartFire.jpg";
+const char* companionCubeTexFileName = "C:/Users/jdtii/ComputerGraphics/Assets/Textures/CompanionCube.png";
+
+// Camera
+int windowWidth = 750, windowHeight = 750;
+int framebufferWidth = 750, framebufferHeight = 750; // pixels, as gl_FragCoord: larger than window on HiDPI
+float fieldOfView = 40;
+ArcCamera camera(windowWidth, windowHeight, vec3(0, 0, 0), vec3(0, 0, -10), fieldOfView);
+int viewChanges = -1; // camera.Changes() when lights and frustum last set
+
+// Lights: portal entrances and, optionally, live particles (world space, particles of previous frame)
+const float PORTAL_LIGHT_RADIUS = 30, PARTICLE_LIGHT_RADIUS = .75f, PARTICLE_LIGHT_SCALE = .3f;
+vec3 portalLights[2];
+bool lightsStale = true;     // pointLights and clusters not of main view
+std::vector<PointLight> particleLights, pointLights;
+std::vector<PointLight> benchLights;   // world space, for -bench
+LightClusters clusters(2);   // texture units 2-4
+DeferredShading deferred(5); // texture units 5-7
+bool deferredOn = false;     // -deferred: G-buffer and light volumes instead of clustered forward
+PointShadows shadows(2, 8);  // portal lights, texture units 8-11
+bool shadowsOn = true;       // forward path only
+
+// Portals: disks within the rings, each a view out of the other, nested through the stencil buffer
+const float PORTAL_RADIUS = .45f, PORTAL_OFFSET = .01f; // offset: in front of black cube face
+const int PORTAL_SEGMENTS = 32, MAX_PORTAL_DEPTH = 4, PORTAL_BUDGET = 16; // budget: passes per frame
+GLuint portalBuffer = 0, portalProgram = 0;
+mat4 portalFrames[2];        // portal to world; local +z is outward normal
+bool portalsOn = false;      // forward path only
+int portalDepth = 2, portalPasses = 0;
+struct PortalLevel {
+	int passes = 0, drawn = 0, culled = 0, hidden = 0; // hidden: passes skipped by occlusion query
+	double ms = 0;           // CPU time issuing passes of this level
+};
+PortalLevel portalStats[MAX_PORTAL_DEPTH + 1];
+OcclusionQueries portalQueries; // disk visibility per portal path, for next frame
+AABB portalBounds(vec3(-PORTAL_RADIUS, -PORTAL_RADIUS, 0), vec3(PORTAL_RADIUS, PORTAL_RADIUS, PORTAL_OFFSET));
+mat4 passView, passPersp;    // view of scene pass being drawn
+
+// Cube Vertices
+float l = -1, r = 1, b = -1, t = 1, n = -1, f = 1; // left, right, bottom, top, near, far
+vec3 vertices[] = { {l,b,n}, {l,b,f}, {l,t,n}, {l,t,f}, {r,b,n}, {r,b,f}, {r,t,n}, {r,t,f} };
+vec3 colors[] = { {1,0,0}, {1,0,0}, {1,1,0}, {1,1,0}, {1,0,1}, {1,0,1}, {0,1,1}, {0,1,1} };
+vec3 normals[] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} }; // outward, per face of quads
+vec2 texs[] = { {0,0}, {0,1}, {1,1}, {1,0} };
+
+// Cube bounds, culled against view frustum in eye space
+AABB cubeBounds = BoundingBox(vertices, 8);
+Frustum frustum;
+
+// Cube Faces
+int quads[][4] = {	// ccw seen from outside, so winding agrees with normals (see CheckLighting)
+	{ 0, 1, 3, 2 },	// left face
+	{ 4, 6, 7, 5 },	// right
+	{ 0, 4, 5, 1 },	// bottom
+	{ 2, 3, 7, 6 },	// top
+	{ 0, 2, 6, 4 },	// near
+	{ 1, 5, 7, 3 }	// far
+};
+
+// Particles
+const float H_VARIANCE = 0.005f;
+const float LIFE_DT = 0.0075f;
+float rand_float(float min = 0, float max = 1) { return min + (float)rand() / (RAND_MAX / (max - min)); }
+
+struct Particle {
+	vec3 pos, vel;
+	vec3 baseColor;
+	vec3 currentColor;
+	float life;
+	Particle() {
+		pos = vec3(0.0f), vel = vec3(0.0f), baseColor = currentColor = vec3(1.0f), life = 0.0f;
+	}
+	void Revive(vec3 new_pos = vec3(0.0f, 0.0f, 0.0f)) {
+		life = 1.0f;
+		pos = new_pos;
+		vel = vec3(rand_float(-H_VARIANCE, H_VARIANCE), rand_float(0.001f, 0.0025f), rand_float(-H_VARIANCE, H_VARIANCE));
+	}
+	void Run() {
+		if (life > 0.0f) {
+			life -= LIFE_DT;
+			pos += vel;
+			currentColor = vec3(0, 1 - life, 0) + baseColor;
+		}
+	}
+};
+int numParticles = 250;
+std::vector<Particle> particles = std::vector<Particle>();
+
+// Interaction
+
+time_t startTime = clock();
+static float cubePosition;
+static float scalar = .3f;
+static bool particlesOn = false, musicOn = false, shaded = true, companionCubeTextured = false, oscillate = false;
+static bool particleLightsOn = false;
+
+// Initialization
+
+void InitVertexBuffer() {
+	// Set duplicated points
+	vec3 pnts[24], nrms[24], cols[24];
+	vec2 uvs[24];
+	for (int f = 0; f < 6; f++) {	    // Each face of cube 
+		for (int k = 0; k < 4; k++) {	// Each corner of face
+			int vid = quads[f][k], count = 4 * f + k;
+			pnts[count] = vertices[vid];
+			cols[count] = colors[vid];
+			nrms[count] = normals[f]; // flat: face normal at each corner
+			uvs[count] = texs[k];
+		}
+	}
+	// Make GPU buffer, set it active
+	glGenBuffers(1, &vBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, vBuffer);
+	// Allocate buffer memory to hold vertex locations and colors
+	int sPnts = sizeof(pnts), sCols = sizeof(cols), sNrms = sizeof(nrms), sUvs = sizeof(uvs);
+	glBufferData(GL_ARRAY_BUFFER, sPnts+sCols+sNrms+sUvs, NULL, GL_STATIC_DRAW);
+	// Load data to the GPU
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sPnts, pnts);
+	glBufferSubData(GL_ARRAY_BUFFER, sPnts, sCols, cols);
+	glBufferSubData(GL_ARRAY_BUFFER, sPnts+sCols, sNrms, nrms);
+	glBufferSubData(GL_ARRAY_BUFFER, sPnts+sCols+sNrms, sUvs, uvs);
+}
+
+void InitPortalBuffer() {
+	// Disk as triangle fan, in portal space
+	vec3 pnts[PORTAL_SEGMENTS + 2];
+	pnts[0] = vec3(0, 0, PORTAL_OFFSET);
+	for (int i = 0; i <= PORTAL_SEGMENTS; i++) {
+		float a = 2 * (float) M_PI * i / PORTAL_SEGMENTS;
+		pnts[i + 1] = vec3(PORTAL_RADIUS * cos(a), PORTAL_RADIUS * sin(a), PORTAL_OFFSET);
+	}
+	glGenBuffers(1, &portalBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, portalBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(pnts), pnts, GL_STATIC_DRAW);
+}
+
+// Shaders
+
+const char *vertexCubeShader = R"(
+	#version 130
+	in vec3 point, color, normal;
+	in vec2 uv;
+	out vec3 vPoint, vColor, vNormal;
+	out vec2 vUv;
+	uniform mat4 modelview, persp;
+	void main() {
+		vPoint = (modelview*vec4(point, 1)).xyz;
+		vNormal = (modelview*vec4(normal, 0)).xyz;
+		gl_Position = persp*vec4(vPoint, 1);
+		vColor = color;
+		vUv = uv;
+	}
+)";
+
+const char *pixelCubeShader = R"(
+	#version 130
+	in vec2 vUv;
+	in vec3 vPoint, vColor, vNormal;
+	out vec4 pColor;
+	// variant flags (see cubeShaders): FLAT_COLOR, TEXTURE, LIGHTING, DEFERRED, SHADOWS
+#ifdef DEFERRED
+	out vec4 gPosition, gNormal;                     // G-buffer, with pColor as albedo
+#endif
+#if defined(FLAT_COLOR)
+	uniform vec3 flatColor;
+#elif defined(TEXTURE)
+	uniform sampler2D textureImage;
+#endif
+#ifdef LIGHTING
+#ifndef DEFERRED
+	float Intensity(vec3 normalV, vec3 eyeV, vec3 point, vec3 light) {
+		vec3 lightV = normalize(light-point);        // light vector
+		vec3 reflectV = reflect(lightV, normalV);    // highlight vector
+		float d = max(0, dot(normalV, lightV));      // one-sided diffuse
+		float s = max(0, dot(reflectV, eyeV));       // one-sided specular
+		return clamp(d+pow(s, 50), 0, 1);
+	}
+)" "#ifdef SHADOWS\n" SHADOW_LOOKUP "#endif\n" CLUSTER_LOOKUP R"(
+#endif
+#endif
+	void main() {
+#if defined(FLAT_COLOR)
+		pColor = vec4(flatColor, 1);
+#elif defined(TEXTURE)
+		pColor = vec4(texture(textureImage, vUv).rgb, 1);
+#else
+		pColor = vec4(vColor, 1);
+#endif
+#ifdef LIGHTING
+		vec3 N = normalize(vNormal);                 // face normal, same at each corner
+#ifdef DEFERRED
+		gNormal = vec4(N, 1);                        // lit in light pass
+#else
+		pColor.rgb *= clamp(ClusterLight(vPoint, N), 0, 1); // only lights reaching this cluster
+#endif
+#elif defined(DEFERRED)
+		gNormal = vec4(0);
+#endif
+#ifdef DEFERRED
+		gPosition = vec4(vPoint, 1);
+#endif
+	}
+)";
+
+const char *vertexParticleShader = R"(
+	#version 130
+	in vec3 point, color;
+	out vec3 vColor;
+	uniform mat4 view;
+	uniform float pointSize = 10;
+	void main() {
+		gl_Position = view*vec4(point, 1);
+		gl_PointSize = pointSize;
+		vColor = color;
+	}
+)";
+
+const char *pixelParticleShader = R"(
+	#version 130
+	in vec3 vColor;
+	out vec4 pColor;
+	void main() {
+		// Round point, like Disk
+		if (length(gl_PointCoord-vec2(.5)) > .5)
+			discard;
+		pColor = vec4(vColor, 1);
+	}
+)";
+
+const char *vertexPortalShader = R"(
+	#version 130
+	in vec3 point;
+	uniform mat4 mvp;
+	void main() {
+		gl_Position = mvp*vec4(point, 1);
+	}
+)";
+
+const char *pixelPortalShader = R"(
+	#version 130
+	out vec4 pColor;
+	void main() {
+		pColor = vec4(0, 0, 0, 1);                   // stencil and depth only
+	}
+)";
+
+// Cube shader variants, one program per flag combination drawn
+enum { FLAT_COLOR = 1, TEXTURE = 2, LIGHTING = 4, DEFERRED = 8, SHADOWS = 16 };
+ShaderVariants cubeShaders(vertexCubeShader, pixelCubeShader, { "FLAT_COLOR", "TEXTURE", "LIGHTING", "DEFERRED", "SHADOWS" });
+
+// -shaders: sources above are defaults, written to files in shaderDir and reloaded there when edited
+const char *shaderDir = "Shaders/PortalIllusion";
+ShaderReload shaderFiles;
+
+void LoadShaderFiles() {
+	// Replace embedded sources with file copies before the first link
+	if (!shaderFiles.Start(shaderDir))
+		return;
+	cubeShaders.Reload(shaderFiles.Source("cube.vert", vertexCubeShader), shaderFiles.Source("cube.frag", pixelCubeShader));
+	vertexParticleShader = shaderFiles.Source("particle.vert", vertexParticleShader);
+	pixelParticleShader = shaderFiles.Source("particle.frag", pixelParticleShader);
+	vertexPortalShader = shaderFiles.Source("portal.vert", vertexPortalShader);
+	pixelPortalShader = shaderFiles.Source("portal.frag", pixelPortalShader);
+	shaderFiles.Add(&cubeShaders, "cube.vert", "cube.frag");
+	shaderFiles.Add(&particleProgram, "particle.vert", "particle.frag");
+	shaderFiles.Add(&portalProgram, "portal.vert", "portal.frag");
+	shaderFiles.retired = [](GLuint p) { glState.Forget(p); };
+	printf("Shaders: %s (saved edits reload while running)\n", shaderDir);
+}
+
+void PrepareCubeShaders(bool forward, bool deferred) {
+	// Black cubes and rings, album art, companion cube (lit or not, textured or not)
+	unsigned int keys[] = { FLAT_COLOR, TEXTURE, LIGHTING, TEXTURE | LIGHTING, 0 };
+	for (unsigned int key : keys) {
+		if (forward)
+			cubeShaders.Prepare(key);
+		if (forward && (key & LIGHTING))
+			cubeShaders.Prepare(key | SHADOWS);
+		if (deferred)
+			cubeShaders.Prepare(key | DEFERRED);
+	}
+}
+
+// Display
+
+void ActivateTextures() {
+	glState.BindTexture(heartFireTexUnit, GL_TEXTURE_2D, heartFireTexName);
+	glState.BindTexture(companionCubeTexUnit, GL_TEXTURE_2D, companionCubeTexName);
+}
+
+void AccessAttributes() {
+	int sVrts = 24 * sizeof(vec3);
+	VertexAttribPointer(cubeProgram, "point", 3, 0, (void*)0);
+	VertexAttribPointer(cubeProgram, "color", 3, 0, (void*)sVrts);
+	VertexAttribPointer(cubeProgram, "normal", 3, 0, (void*)(2 * sVrts));
+	VertexAttribPointer(cubeProgram, "uv", 2, 0, (void*)(3 * sVrts));
+}
+
+void AnimateDrawParticles(mat4 tran, vec3 color) {
+	// Stream live particles (point, color) into this frame's region, draw as one batch
+	GLintptr offset = 0;
+	vec3 *p = (vec3 *) particleStream.Alloc(numParticles * 2 * sizeof(vec3), offset);
+	if (!p)
+		return;
+	int nLive = 0;
+	for (int i = 0; i < numParticles; i++) {
+		if (particles[i].life > 0.0f) {
+			particles[i].baseColor = color;
+			particles[i].Run();
+			vec4 res = tran * vec4(particles[i].pos, 1);
+			p[2 * nLive] = vec3(res.x, res.y, res.z);
+			p[2 * nLive + 1] = particles[i].currentColor;
+			if (particleLightsOn)
+				particleLights.push_back(PointLight(p[2 * nLive], PARTICLE_LIGHT_RADIUS, PARTICLE_LIGHT_SCALE * particles[i].currentColor));
+			nLive++;
+		}
+	}
+	if (!nLive)
+		return;
+	particleStream.Commit();
+	glState.BindBuffer(GL_ARRAY_BUFFER, particleStream.Buffer());
+	int stride = 2 * sizeof(vec3);
+	VertexAttribPointer(particleProgram, "point", 3, stride, (void *) offset);
+	VertexAttribPointer(particleProgram, "color", 3, stride, (void *) (offset + sizeof(vec3)));
+	glDrawArrays(GL_POINTS, 0, nLive);
+}
+
+void BuildLights(mat4 view, mat4 persp) {
+	// Gather portal, particle and benchmark lights in eye space; forward path bins them into view clusters
+	pointLights.clear();
+	for (vec3 l : portalLights) {
+		vec4 e = view * vec4(l, 1);
+		pointLights.push_back(PointLight(vec3(e.x, e.y, e.z), PORTAL_LIGHT_RADIUS));
+	}
+	for (std::vector<PointLight> *world : { &particleLights, &benchLights })
+		for (PointLight l : *world) {
+			vec4 e = view * vec4(l.position, 1);
+			l.position = vec3(e.x, e.y, e.z);
+			pointLights.push_back(l);
+		}
+	if (deferredOn)
+		return;
+	clusters.Build(pointLights, persp, framebufferWidth, framebufferHeight);
+	glState.InvalidateTextures();
+	ActivateTextures();
+}
+
+void UseCubeVariant(unsigned int key) {
+	// Bind variant; its attributes and per-frame uniforms are set on each switch
+	GLuint p = cubeShaders.Program(key);
+	if (p == cubeProgram)
+		return;
+	glState.UseProgram(cubeProgram = p);
+	AccessAttributes();
+	glState.SetUniform(p, "persp", passPersp);
+	if (key & DEFERRED)
+		deferred.SetOutputs(p);
+	else if (key & LIGHTING)
+		clusters.Use(glState, p);
+	if (key & SHADOWS) {
+		shadows.Use(glState, p);
+		glState.SetUniform(p, "view", passView);
+	}
+}
+
+void ShadeCube(bool faceted, bool textured, mat4 m, vec3 color = vec3(1), int texUnit = 0) {
+	if (!frustum.Visible(m, cubeBounds))
+		return;
+	unsigned int key = textured ? TEXTURE : faceted ? 0 : FLAT_COLOR;
+	if (faceted && shaded)
+		key |= LIGHTING;
+	if (deferredOn)
+		key |= DEFERRED;
+	else if (shadowsOn && (key & LIGHTING))
+		key |= SHADOWS;
+	UseCubeVariant(key);
+	glState.SetUniform(cubeProgram, "modelview", m);
+	if (key & FLAT_COLOR)
+		glState.SetUniform(cubeProgram, "flatColor", color);
+	if (key & TEXTURE)
+		glState.SetUniform(cubeProgram, "textureImage", texUnit);
+	glDrawArrays(GL_QUADS, 0, 24);
+}
+
+// Scene
+
+struct CubeDraw {
+	mat4 world;
+	bool faceted, textured, dynamic;  // dynamic: moves, so re-rendered into shadow maps every frame
+	vec3 color;
+	int texUnit;
+	CubeDraw(mat4 w, bool f, bool t, bool d, vec3 c, int u = 0) : world(w), faceted(f), textured(t), dynamic(d), color(c), texUnit(u) { }
+};
+std::vector<CubeDraw> scene;
+
+void RenderShadows() {
+	// Depth-only draws of scene casters into each face that sees them; static casters only when cache invalid
+	shadows.Render(glState, [](Frustum &face, bool dynamic) {
+		GLuint p = shadows.Program();
+		glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer);
+		VertexAttribPointer(p, "point", 3, 0, (void*)0);
+		int n = 0;
+		for (CubeDraw &c : scene)
+			if (c.dynamic == dynamic && face.Visible(c.world, cubeBounds)) {
+				glState.SetUniform(p, "model", c.world);
+				glDrawArrays(GL_QUADS, 0, 24);
+				n++;
+			}
+		return n;
+	});
+}
+
+void DrawScene(mat4 view, mat4 persp, int level) {
+	// Scene as seen from view; level > 0 is a view through a portal, its near plane the far portal
+	auto start = std::chrono::steady_clock::now();
+	int submitted = frustum.submitted, culled = frustum.culled;
+	passView = view;
+	passPersp = persp;
+	frustum.Set(persp);
+	if (level > 0 || lightsStale) {
+		BuildLights(view, camera.persp); // clusters slice eye depth, unaffected by oblique near plane
+		lightsStale = level > 0;
+	}
+	glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer);
+	cubeProgram = 0; // portal, particle or shadow program was bound last
+	ActivateTextures();
+	for (CubeDraw &c : scene)
+		ShadeCube(c.faceted, c.textured, view * c.world, c.color, c.texUnit);
+	PortalLevel &s = portalStats[level];
+	s.passes++;
+	s.drawn += (frustum.submitted - submitted) - (frustum.culled - culled);
+	s.culled += frustum.culled - culled;
+	s.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Portals
+
+float Sign(float f) { return f > 0 ? 1.f : f < 0 ? -1.f : 0.f; }
+
+mat4 RigidInverse(mat4 m) {
+	// Inverse of rotation and translation: transposed rotation, negated translation rotated back
+	mat4 inv;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++)
+			inv[i][j] = m[j][i];
+		inv[i][3] = -(m[0][i] * m[0][3] + m[1][i] * m[1][3] + m[2][i] * m[2][3]);
+	}
+	return inv;
+}
+
+mat4 PortalView(mat4 view, int i) {
+	// Entering portal i exits the other: scene in front of it, turned about y to lie behind portal i
+	return view * portalFrames[i] * RotateY(180) * RigidInverse(portalFrames[1 - i]);
+}
+
+vec4 PortalPlane(mat4 view, int i) {
+	// Plane of portal i in eye space, positive on its outward side; w > 0 if camera in front
+	mat4 m = view * portalFrames[i];
+	vec4 n = m * vec4(0, 0, 1, 0), p = m * vec4(0, 0, 0, 1);
+	return vec4(n.x, n.y, n.z, -(n.x * p.x + n.y * p.y + n.z * p.z));
+}
+
+mat4 ObliqueProjection(mat4 persp, vec4 plane) {
+	// Replace near plane with eye space plane (camera on its negative side), keeping far (Lengyel 2005)
+	vec4 q((Sign(plane.x) + persp[0][2]) / persp[0][0], (Sign(plane.y) + persp[1][2]) / persp[1][1], -1, (1 + persp[2][2]) / persp[2][3]);
+	vec4 c = plane * (2 / dot(plane, q));
+	for (int k = 0; k < 4; k++)
+		persp[2][k] = c[k] - persp[3][k];
+	return persp;
+}
+
+void DrawPortal(mat4 view, mat4 persp, int i) {
+	glState.UseProgram(AwaitProgram(portalProgram));
+	glState.BindBuffer(GL_ARRAY_BUFFER, portalBuffer);
+	VertexAttribPointer(portalProgram, "point", 3, 0, (void*)0);
+	glState.SetUniform(portalProgram, "mvp", persp * view * portalFrames[i]);
+	glDrawArrays(GL_TRIANGLE_FAN, 0, PORTAL_SEGMENTS + 2);
+}
+
+void StencilPortal(mat4 view, mat4 persp, int i, int ref, GLenum op) {
+	// Stencil-only disk: op applies where stencil equals ref (test fails there, nothing else written)
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glState.Disable(GL_DEPTH_TEST);
+	glState.Enable(GL_STENCIL_TEST);
+	glStencilMask(0xFF);
+	glStencilFunc(GL_NOTEQUAL, ref, 0xFF);
+	glStencilOp(op, GL_KEEP, GL_KEEP);
+	DrawPortal(view, persp, i);
+}
+
+void RenderPortals(mat4 view, mat4 persp, int level, int path = 0) {
+	// Stencil holds recursion level: each portal seen from this level raises its disk to level+1, the view
+	// through it is drawn there (recursively), then the disk is lowered back; last, this level's scene
+	// is drawn where stencil equals level, behind depth of the portals drawn through
+	// path identifies the portals this level is seen through (base 3, one digit per level)
+	bool tested[2] = { false, false }, through[2] = { false, false };
+	Frustum levelFrustum;
+	levelFrustum.Set(persp);
+	for (int i = 0; i < 2; i++) {
+		// Recurse only into portals facing camera and within this level's frustum, not hidden last
+		// frame, while within budget
+		if (level >= portalDepth || PortalPlane(view, i).w <= 0 || !levelFrustum.Visible(view * portalFrames[i], portalBounds))
+			continue;
+		tested[i] = portalQueries.enabled;
+		if (!portalQueries.Visible(3 * path + i + 1)) {
+			portalStats[level].hidden++;
+			continue;
+		}
+		if (portalPasses >= PORTAL_BUDGET)
+			continue;
+		through[i] = true;
+		portalPasses++;
+		StencilPortal(view, persp, i, level, GL_INCR);
+		mat4 v = PortalView(view, i);
+		RenderPortals(v, ObliqueProjection(persp, PortalPlane(v, 1 - i)), level + 1, 3 * path + i + 1);
+		StencilPortal(view, persp, i, level + 1, GL_DECR);
+	}
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_TRUE);
+	glState.Disable(GL_STENCIL_TEST);
+	glState.Enable(GL_DEPTH_TEST);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glDepthFunc(GL_ALWAYS);
+	for (int i = 0; i < 2; i++)
+		if (through[i])
+			DrawPortal(view, persp, i);
+	glDepthFunc(GL_LESS);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glState.Enable(GL_STENCIL_TEST);
+	glStencilMask(0);
+	glStencilFunc(GL_EQUAL, level, 0xFF);
+	DrawScene(view, persp, level);
+	// Test portal disks against this level's scene, within its region; read next frame
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glDepthFunc(GL_LEQUAL); // disks drawn through already hold their own depth
+	for (int i = 0; i < 2; i++)
+		if (tested[i]) {
+			portalQueries.Begin(3 * path + i + 1);
+			DrawPortal(view, persp, i);
+			portalQueries.End();
+		}
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void PrintPortalStats() {
+	printf("Portals %s, depth %i: %i of %i passes\n", portalsOn ? "enabled" : "disabled", portalDepth, portalPasses, PORTAL_BUDGET);
+	for (int l = 0; l <= portalDepth; l++) {
+		PortalLevel &s = portalStats[l];
+		printf("  level %i: %i passes, %i cubes drawn, %i culled, %i portals hidden, %.2f ms\n", l, s.passes, s.drawn, s.culled, s.hidden, s.ms);
+	}
+	portalQueries.PrintStats(portalQueries.enabled ? "Occlusion queries" : "Occlusion queries (disabled)");
+}
+
+void Display(GLFWwindow *w) {
+	glState.NewFrame();
+	// Clear background
+	glClearColor(0, 0, 0, 1);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+	glState.Enable(GL_DEPTH_TEST);
+	// Init shader program, set vertex pull for points and colors
+	glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer); 
+	glState.Enable(GL_BLEND);
+	glState.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// Portal positions
+	float dt = (float)(clock() - startTime) / CLOCKS_PER_SEC;
+	mat4 persp = camera.persp;
+	mat4 m1 = Translate(3.25f, 0, 0) * Scale(1.25f, 1.5, 1), m2 = Translate(-3.25f, 0, 0) * Scale(1.25f, 1.5, 1);
+	mat4 m3 = Translate(0, (2.5f + 0.25f * cos(1.5f * dt)), -3.f) * RotateY(180) * Scale(1.5f, 1.5f, 0.005f);
+	mat4 m4 = RotateX(30 * dt) * RotateX(45) * RotateY(45) * Scale(.2f);
+	mat4 mOsc1 = Translate(0, cos(dt), 0), mOsc2 = Translate(0, -cos(dt), 0); // Portal oscillations
+	mat4 p1 = Translate(2.f, 0, 0) * Scale(1.25f, 1, 1) * RotateZ(90), p2 = Translate(-2.f, 0, 0) * Scale(1.25f, 1, 1) * RotateZ(-90);
+	portalFrames[0] = (oscillate ? mOsc1 : mat4(1.f)) * Translate(2.f, 0, 0) * RotateY(-90);  // facing -x
+	portalFrames[1] = (oscillate ? mOsc2 : mat4(1.f)) * Translate(-2.f, 0, 0) * RotateY(90);  // facing +x
+	// Transform portal entrances, set lights (a light that hasn't moved keeps its shadow map;
+	// eye-space lights and clusters are rebuilt only when the view or particles move)
+	vec4 e1 = m1 * vec4(-1, 0, 0, 1), e2 = m2 * vec4(1, 0, 0, 1);
+	vec3 entrance1(e1.x, e1.y, e1.z), entrance2(e2.x, e2.y, e2.z);       // Portal entrances
+	shadows.SetLight(0, entrance1);
+	shadows.SetLight(1, entrance2);
+	portalLights[0] = entrance1;
+	portalLights[1] = entrance2;
+	if (camera.Changed(viewChanges) || particleLightsOn) // particles move every frame
+		lightsStale = true;
+	frustum.ResetStats();
+	// Scene, in world space; black cubes and rings are static unless oscillating
+	scene.clear();
+	// Black cubes
+	scene.push_back(CubeDraw((oscillate ? mOsc1 : mat4(1.f)) * m1, false, false, oscillate, vec3(0, 0, 0)));
+	scene.push_back(CubeDraw((oscillate ? mOsc2 : mat4(1.f)) * m2, false, false, oscillate, vec3(0, 0, 0)));
+	// Textured album art cube
+	if (musicOn)
+		scene.push_back(CubeDraw(m3, false, true, true, vec3(1), heartFireTexUnit));
+	// Portal entrances (rings)
+	const int NUM_MINI_CUBES = 60;
+	for (int i = 1; i <= NUM_MINI_CUBES; i++) {
+		mat4 miniCubeTran = RotateX((float)i * 360 / NUM_MINI_CUBES) * Translate(0, 0, .5f) * Scale(.1f, .05f, .05f);
+		scene.push_back(CubeDraw((oscillate ? mOsc1 : mat4(1.f)) * Translate(2.0f, 0, 0) * miniCubeTran, false, false, oscillate, vec3(0, 0, 1)));
+		scene.push_back(CubeDraw((oscillate ? mOsc2 : mat4(1.f)) * Translate(-2.0f, 0, 0) * miniCubeTran, false, false, oscillate, vec3(1, 0.5, 0)));
+	}
+	// Portal cubes
+	cubePosition = 2 * cos(dt);
+	scene.push_back(CubeDraw(Translate(-2 + cubePosition, 0, 0) * m4, true, companionCubeTextured, true, vec3(1), companionCubeTexUnit));
+	scene.push_back(CubeDraw(Translate(2 + cubePosition, 0, 0) * m4, true, companionCubeTextured, true, vec3(1), companionCubeTexUnit));
+	// Shadows of portal lights
+	if (shadowsOn && shaded && !deferredOn)
+		RenderShadows();
+	// Start rendering objects
+	glState.Enable(GL_DEPTH_TEST);
+	glState.Enable(GL_BLEND);
+	for (PortalLevel &s : portalStats)
+		s = PortalLevel();
+	portalPasses = 0;
+	portalQueries.NewFrame();
+	if (deferredOn) {
+		// Deferred lighting
+		deferred.BeginGeometry(glState);
+		DrawScene(camera.modelview, persp, 0);
+		deferred.EndGeometry();
+		deferred.Light(glState, pointLights, persp);
+		glState.Enable(GL_BLEND);
+		glState.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else if (portalsOn) {
+		RenderPortals(camera.modelview, persp, 0);
+		glStencilMask(0xFF);
+		glState.Disable(GL_STENCIL_TEST);
+	}
+	else
+		DrawScene(camera.modelview, persp, 0);
+	// Particles, seen in main view only
+	glState.Disable(GL_DEPTH_TEST);
+	glState.Enable(GL_PROGRAM_POINT_SIZE);
+	glState.UseProgram(AwaitProgram(particleProgram));
+	glState.SetUniform(particleProgram, "view", camera.fullview);
+	particleStream.BeginFrame();
+	particleLights.clear();
+	glState.InvalidateBuffer(GL_ARRAY_BUFFER); // orphaning fallback binds its buffer
+	AnimateDrawParticles(p1, vec3(0, 0, 1)); 
+	AnimateDrawParticles(p2, vec3(1, 0, 0));
+	particleStream.EndFrame();
+	glFlush();
+}
+
+// Particle
+
+const vec2 GRAVITY = vec2(0.0f, -0.00025f);
+const float PARTICLE_SIZE = 2.0f;
+const int NUM_PARTICLES_SPAWNED = 1;
+
+int lastUsedParticle = 0;
+bool spaceDown = false;
+
+int FindNextParticle() {
+	// Search for dead particle from last used particle
+	for (int i = lastUsedParticle; i < numParticles; i++) {
+		if (particles[i].life <= 0.0f) {
+			lastUsedParticle = i;
+			return i;
+		}
+	}
+	// Search linearly through rest of particles
+	for (int i = 0; i < lastUsedParticle; i++) {
+		if (particles[i].life <= 0.0f) {
+			lastUsedParticle = i;
+			return i;
+		}
+	}
+	// If no dead particles exist, simply take the first particle
+	lastUsedParticle = 0;
+	return 0;
+}
+
+void SpawnParticle(GLFWwindow* w) {
+	vec3 m = vec3(0, 0, 0);
+	for (int i = 0; i < NUM_PARTICLES_SPAWNED; i++) {
+		int p = FindNextParticle();
+		particles[p].Revive(m);
+	}
+}
+
+// User Callbacks
+
+void MouseButton(GLFWwindow* w, int butn, int action, int mods) {
+	// Called when mouse button pressed or released
+	if (action == GLFW_PRESS) {
+		// Save reference for MouseDrag
+		double x, y;
+		glfwGetCursorPos(w, &x, &y);
+		camera.MouseDown((int)x, (int)y);
+	}
+	if (action == GLFW_RELEASE) {
+		// Save reference rotation
+		camera.MouseUp();
+	}
+}
+
+void MouseMove(GLFWwindow* w, double x, double y) {
+	if (glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+		camera.MouseDrag((int)x, (int)y, Shift());
+}
+
+void MouseWheel(GLFWwindow* w, double ignore, double spin) {
+	camera.MouseWheel(spin > 0, Shift());
+}
+
+void Keyboard(GLFWwindow* w, int key, int scancode, int action, int mods) {
+	if (action == GLFW_PRESS) {
+		if (key == GLFW_KEY_ESCAPE)
+			glfwSetWindowShouldClose(w, GLFW_TRUE);
+		// Field of view
+		float fieldOfView = camera.GetFOV();
+		bool shift = mods & GLFW_MOD_SHIFT;
+		fieldOfView += key == 'F' ? shift ? -5 : 5 : 0;
+		fieldOfView = fieldOfView < 5 ? 5 : fieldOfView > 150 ? 150 : fieldOfView;
+		camera.SetFOV(fieldOfView);
+		// Toggle light, shaded cube
+		if (key == GLFW_KEY_L) {
+			shaded = !shaded;
+			printf("Shading %s\n", shaded ? "enabled" : "disabled");
+		}
+		// Toggle particle lights
+		if (key == GLFW_KEY_K) {
+			particleLightsOn = !particleLightsOn;
+			particleLights.clear();
+			BuildLights(camera.modelview, camera.persp);
+			lightsStale = false;
+			printf("Particle lights %s\n", particleLightsOn ? "enabled" : "disabled");
+			clusters.PrintStats("Last frame");
+		}
+		// Toggle particles
+		if (key == GLFW_KEY_P) {
+			particlesOn = !particlesOn;
+			printf("Particles %s\n", particlesOn ? "enabled" : "disabled");
+		}
+		// Toggle music
+		if (key == GLFW_KEY_M) {
+			if (!musicOn) {
+				// Play audio. EXULGOR - Untitled 001
+				PlaySound(0, 0, 0);
+				PlaySound(TEXT("C:/Users/jdtii/ComputerGraphics/Assets/Audio/EXULGOR_Untitled001"), NULL, SND_FILENAME | SND_ASYNC | SND_LOOP);
+				printf("Playing: EXULGOR - Untitled 001\n");
+				musicOn = !musicOn;
+			}
+			else {
+				// Stop playing music
+				PlaySound(0, 0, 0);
+				printf("No music is playing\n");
+				musicOn = !musicOn;
+			}
+		}
+		// Toggle texture
+		if (key == GLFW_KEY_T) {
+			companionCubeTextured = !companionCubeTextured;
+			printf("Texture %s\n", companionCubeTextured ? "enabled" : "disabled");
+		}
+		// Toggle frustum culling
+		if (key == GLFW_KEY_C) {
+			frustum.enabled = !frustum.enabled;
+			printf("Culling %s\n", frustum.enabled ? "enabled" : "disabled");
+			frustum.PrintStats("Last frame");
+		}
+		// Print GL calls of last frame
+		if (key == GLFW_KEY_G) {
+			glState.PrintStats("Last frame");
+			GLCountPrint("PortalIllusion");
+		}
+		// Toggle shadows
+		if (key == GLFW_KEY_H) {
+			shadowsOn = !shadowsOn;
+			printf("Shadows %s\n", shadowsOn ? "enabled" : "disabled");
+			shadows.PrintStats("Last frame");
+		}
+		// Toggle portal oscillation
+		if (key == GLFW_KEY_O) {
+			oscillate = !oscillate;
+			shadows.InvalidateStatic(); // rings and black cubes change between static and dynamic
+			printf("Oscillation %s\n", oscillate ? "enabled" : "disabled");
+		}
+		// Toggle recursive portals, adjust recursion depth
+		if (key == GLFW_KEY_R) {
+			portalsOn = !portalsOn;
+			PrintPortalStats();
+		}
+		// Toggle occlusion queries of portal disks
+		if (key == GLFW_KEY_Q) {
+			portalQueries.enabled = !portalQueries.enabled;
+			PrintPortalStats();
+		}
+		if (key == GLFW_KEY_LEFT_BRACKET || key == GLFW_KEY_RIGHT_BRACKET) {
+			portalDepth += key == GLFW_KEY_RIGHT_BRACKET ? 1 : -1;
+			portalDepth = portalDepth < 1 ? 1 : portalDepth > MAX_PORTAL_DEPTH ? MAX_PORTAL_DEPTH : portalDepth;
+			PrintPortalStats();
+		}
+	}
+}
+
+// Credit & Usage
+
+const char* credit = "\n\
+	      Created by Justin Thoreson\n\
+ Special thanks to Jules Bloomenthal & Devon McKee\n\n\
+-------------------------------------------------------\n\
+";
+
+const char* usage = "\n\
+            LEFT-CLICK + DRAG: adjust view\n\
+    SHIFT + LEFT-CLICK + DRAG: move objects\n\
+                       SCROLL: rotate view\n\
+               SHIFT + SCROLL: zoom in and out\n\
+               F or SHIFT + F: adjust field of view\n\
+                            L: toggle lighting/shading\n\
+                            P: toggle particles\n\
+                            K: toggle particle lights\n\
+                            M: toggle music\n\
+                            T: toggle texture\n\
+                            O: toggle oscillation\n\
+                            H: toggle shadows\n\
+                            R: toggle recursive portals\n\
+                       [ or ]: adjust portal recursion depth\n\
+                            Q: toggle occlusion queries of portals\n\
+                            C: toggle frustum culling\n\
+                            G: print GL calls issued/elided\n\n\
+                    -deferred: G-buffer and light volumes\n\
+                       -bench: time forward vs deferred, 2-1000 lights\n\
+                     -shaders: load shaders from files, reload when saved\n\
+                       -check: test cube normals and lit face shades, then exit\n\n\
+-------------------------------------------------------\n\
+";
+
+// Application
+
+void PrintProgramInfo() {
+	printf("GL version: %s\n\n", glGetString(GL_VERSION));
+	printf("Credit:\n%s\n", credit);
+	printf("Usage:\n%s\n", usage);
+	printf("Toggles:\n\n");
+}
+
+void Resize(GLFWwindow* w, int width, int height) {
+	camera.Resize(windowWidth = width, windowHeight = height);
+}
+
+void ResizeFramebuffer(GLFWwindow* w, int width, int height) {
+	glViewport(0, 0, framebufferWidth = width, framebufferHeight = height);
+	deferred.Resize(framebufferWidth, framebufferHeight);
+}
+
+void InitCallbacks(GLFWwindow* w) {
+	glfwSetMouseButtonCallback(w, MouseButton);
+	glfwSetCursorPosCallback(w, MouseMove);
+	glfwSetScrollCallback(w, MouseWheel);
+	glfwSetWindowSizeCallback(w, Resize);
+	glfwSetFramebufferSizeCallback(w, ResizeFramebuffer);
+	glfwSetKeyCallback(w, Keyboard);
+}
+
+void InitTextures() {
+	heartFireTexName = textureLoader.Load(heartFireTexFileName, heartFireTexUnit);
+	companionCubeTexName = textureLoader.Load(companionCubeTexFileName, companionCubeTexUnit);
+}
+
+void InitParticles() {
+	for (int i = 0; i < numParticles; i++)
+		particles.push_back(Particle());
+}
+
+void EmitParticles(GLFWwindow* w) {
+	bool thresholdCrossed = cubePosition < 0.5 && cubePosition > -0.5;
+	if (thresholdCrossed && particlesOn)
+		SpawnParticle(w);
+}
+
+void Close() {
+	// Unbind vertex buffer and free GPU memory
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glDeleteBuffers(1, &vBuffer);
+	glDeleteBuffers(1, &portalBuffer);
+	glDeleteBuffers(1, &heartFireTexName);
+	if (particleStream.stalls)
+		printf("Particle stream waited on GPU %i times\n", particleStream.stalls);
+	particleStream.Release();
+	clusters.Release();
+	deferred.Release();
+	shadows.Release();
+	portalQueries.Release();
+	textureLoader.Release();
+	shaderFiles.Stop();
+}
+
+// Lighting check
+
+bool CheckLighting() {
+	// -check: baked normals agree with winding and point outward; then a lit cube, drawn offscreen
+	// by the forward cube shader, must match per-face shades evaluated here, each face distinct
+	bool ok = true;
+	for (int f = 0; f < 6; f++) {
+		vec3 p[4], center(0, 0, 0);
+		for (int k = 0; k < 4; k++)
+			center += (p[k] = vertices[quads[f][k]]) / 4;
+		vec3 wound = normalize(cross(p[1] - p[0], p[2] - p[1]));
+		if (dot(wound, normals[f]) < .999f || dot(normals[f], center) <= 0) {
+			printf("face %i: normal (%g, %g, %g) disagrees with winding or points inward\n", f, normals[f].x, normals[f].y, normals[f].z);
+			ok = false;
+		}
+	}
+	const int size = 256;
+	GLuint framebuffer = 0, buffers[2] = { 0, 0 };
+	glGenFramebuffers(1, &framebuffer);
+	glGenRenderbuffers(2, buffers);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, buffers[0]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size, size);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, buffers[0]);
+	glBindRenderbuffer(GL_RENDERBUFFER, buffers[1]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, buffers[1]);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		printf("lighting check: can't make framebuffer\n");
+		ok = false;
+	}
+	else {
+		// left, top and far faces toward the eye, light up and to the left
+		mat4 persp = Perspective(40, 1, .1f, 100), modelview = Translate(0, 0, -8) * RotateX(30) * RotateY(40);
+		PointLight light(vec3(-3, 4, 2), 30);
+		clusters.Build({ light }, persp, size, size);
+		glState.InvalidateTextures();
+		glViewport(0, 0, size, size);
+		glClearColor(0, 0, 0, 1);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glState.Enable(GL_DEPTH_TEST);
+		glState.Disable(GL_BLEND);
+		glState.BindBuffer(GL_ARRAY_BUFFER, vBuffer);
+		passPersp = persp;
+		cubeProgram = 0;
+		UseCubeVariant(LIGHTING);
+		glState.SetUniform(cubeProgram, "modelview", modelview);
+		glDrawArrays(GL_QUADS, 0, 24);
+		float shades[6];
+		int nFacing = 0;
+		for (int f = 0; f < 6; f++) {
+			// face center, where the quad's diagonal (corners 0 and 2) splits it
+			const int *q = quads[f];
+			vec4 c4 = modelview * vec4((vertices[q[0]] + vertices[q[2]]) / 2, 1), n4 = modelview * vec4(normals[f], 0);
+			vec3 point(c4.x, c4.y, c4.z), N = normalize(vec3(n4.x, n4.y, n4.z)), E = normalize(point);
+			if (dot(N, E) >= 0)
+				continue;                                // faces away: hidden
+			vec3 L = normalize(light.position - point), R = L - 2 * dot(N, L) * N;
+			float d = length(light.position - point) / light.radius, w = 1 - d * d * d * d, s = dot(R, E);
+			float intensity = (dot(N, L) > 0 ? dot(N, L) : 0) + (s > 0 ? pow(s, 50) : 0);
+			intensity = (w > 0 ? w * w : 0) * (intensity < 1 ? intensity : 1);
+			vec3 expect = intensity * (colors[q[0]] + colors[q[2]]) / 2;
+			vec4 ndc = persp * c4;
+			int x = (int) ((ndc.x / ndc.w * .5f + .5f) * size), y = (int) ((ndc.y / ndc.w * .5f + .5f) * size);
+			unsigned char rgba[4];
+			glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+			vec3 got(rgba[0] / 255.f, rgba[1] / 255.f, rgba[2] / 255.f), e = got - expect;
+			bool match = fabs(e.x) < .04f && fabs(e.y) < .04f && fabs(e.z) < .04f;  // 8-bit, a texel off center
+			printf("face %i: expected (%.2f, %.2f, %.2f), drawn (%.2f, %.2f, %.2f)%s\n", f,
+				   expect.x, expect.y, expect.z, got.x, got.y, got.z, match ? "" : " MISMATCH");
+			ok &= match;
+			for (int i = 0; i < nFacing; i++)
+				if (fabs(shades[i] - intensity) < .05f) {
+					printf("face %i: shade %.2f too close to another face's\n", f, intensity);
+					ok = false;
+				}
+			shades[nFacing++] = intensity;
+		}
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, framebufferWidth, framebufferHeight);
+	glDeleteRenderbuffers(2, buffers);
+	glDeleteFramebuffers(1, &framebuffer);
+	lightsStale = true;
+	printf("Lighting check %s\n", ok ? "passed" : "FAILED");
+	return ok;
+}
+
+// Benchmark
+
+void Benchmark(GLFWwindow *w) {
+	// Frame time of forward (clustered) vs deferred paths as lights grow from 2 (portals only) to 1000
+	const int counts[] = { 2, 10, 50, 100, 250, 500, 1000 }, nFrames = 30;
+	bool wasDeferred = deferredOn, wasShadowed = shadowsOn;
+	shadowsOn = false; // deferred path is unshadowed; compare lighting alone
+	glfwSwapInterval(0);
+	printf("%8s %12s %12s\n", "lights", "forward ms", "deferred ms");
+	for (int n : counts) {
+		benchLights.clear();
+		srand(n);
+		for (int i = 2; i < n; i++) {
+			vec3 p(rand_float(-4, 4), rand_float(-2, 2), rand_float(-2, 2)), c(rand_float(), rand_float(), rand_float());
+			benchLights.push_back(PointLight(p, 1.5f, .5f * c));
+		}
+		double ms[2];
+		for (int d = 0; d < 2; d++) {
+			deferredOn = d == 1;
+			viewChanges = -1; // rebuild lights
+			for (int f = 0; f < 3; f++) {
+				Display(w);
+				glfwSwapBuffers(w);
+			}
+			glFinish();
+			auto start = std::chrono::steady_clock::now();
+			for (int f = 0; f < nFrames; f++) {
+				Display(w);
+				glfwSwapBuffers(w);
+			}
+			glFinish();
+			ms[d] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / nFrames;
+		}
+		printf("%8i %12.2f %12.2f\n", n, ms[0], ms[1]);
+	}
+	benchLights.clear();
+	deferredOn = wasDeferred;
+	shadowsOn = wasShadowed;
+	viewChanges = -1;
+	glfwSwapInterval(1);
+}
+
+int main(int ac, char **av) {
+	bool bench = false, hotShaders = false, check = false;
+	for (int i = 1; i < ac; i++) {
+		check |= !strcmp(av[i], "-check");
+		deferredOn |= !strcmp(av[i], "-deferred");
+		bench |= !strcmp(av[i], "-bench");
+		hotShaders |= !strcmp(av[i], "-shaders");
+	}
+	srand((int) time(NULL));
+	// Init GLFW library and create window
+	if (!glfwInit())
+		return 1;
+	glfwWindowHint(GLFW_SAMPLES, 4); // Anti-alias
+	glfwWindowHint(GLFW_STENCIL_BITS, 8); // Portal recursion levels
+	GLFWwindow *window = glfwCreateWindow(windowWidth, windowHeight, "Portal Illusion", NULL, NULL);
+	if (!window) {
+		glfwTerminate();
+		return 1;
+	}
+	glfwMakeContextCurrent(window);
+	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	GLCountInstall(); // count GL calls per frame
+	PrintProgramInfo();
+	PrintGLErrors();
+	// Start shader program links; Display waits on them at first use
+	EnableParallelShaderCompile((GLADloadproc) glfwGetProcAddress);
+	if (hotShaders)
+		LoadShaderFiles();
+	PrepareCubeShaders(!deferredOn || bench || check, deferredOn || bench);
+	particleProgram = LinkProgramCachedAsync(&vertexParticleShader, &pixelParticleShader);
+	portalProgram = LinkProgramCachedAsync(&vertexPortalShader, &pixelPortalShader);
+	InitVertexBuffer();
+	InitPortalBuffer();
+	particleStream.Init();
+	textureLoader.Init();
+	clusters.Init();
+	shadows.Init();
+	if (deferredOn || bench)
+		deferred.Init(framebufferWidth, framebufferHeight);
+	printf("Lighting: %s\n", deferredOn ? "deferred" : "clustered forward");
+	printf("Particle stream: %s\n", particleStream.Persistent() ? "persistent mapped" : "orphaned");
+	InitParticles();       // Set particles
+	InitCallbacks(window); // Set callbacks for device interaction
+	glfwSwapInterval(1);   // Ensure no generated frame backlog
+	InitTextures();        // Set textures
+	if (check) {
+		bool passed = CheckLighting();
+		Close();
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		return passed ? 0 : 1;
+	}
+	if (bench) {
+		Benchmark(window); // run with LIBGL_ALWAYS_SOFTWARE=1 to time under llvmpipe
+		glfwSetWindowShouldClose(window, GLFW_TRUE);
+	}
+	// Event loop
+	while (!glfwWindowShouldClose(window)) {
+		shaderFiles.Poll(); // swap in edited shaders once linked
+		if (textureLoader.Update())
+			glState.InvalidateTextures();
+		Display(window);
+		GLCountNewFrame();
+		EmitParticles(window);
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+	}
+	// Terminate program, clean up
+	Close();
+	PrintProgramCacheStats("PortalIllusion"); // cold (compiled) vs warm (cached) startup
+	PrintTextureCacheStats("PortalIllusion");
+	GLCountPrint("PortalIllusion");
+	glfwDestroyWindow(window);
+	glfwTerminate();
+}
@@ -0,0 +1,63 @@
+// ArcCamera.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Quaternion arcball camera shared by the apps
+
+#ifndef ARCCAMERA_HDR
+#define ARCCAMERA_HDR
+
+#include "VecMat.h"
+
+// Quaternion
+
+struct Quat {
+	float x, y, z, w;
+	Quat(float x = 0, float y = 0, float z = 0, float w = 1) : x(x), y(y), z(z), w(w) { }
+	Quat(vec3 axis, float degrees);
+	Quat operator*(const Quat &q) const;
+	Quat Normalized() const;
+	mat4 GetMatrix() const;
+};
+
+// Arcball Camera
+//   matrices (rot, tran, modelview, persp, fullview) are rebuilt only by the input
+//   and setter calls below, never per frame; Changes() counts those rebuilds so a
+//   renderer can skip re-uploading view uniforms when nothing has moved
+
+class ArcCamera {
+public:
+	mat4 rot, tran;                   // current rotation, translation
+	mat4 modelview, persp, fullview;  // fullview = persp*modelview
+	float tranSpeed = .005f;          // translation per pixel of shift-drag
+	float zoomSpeed = .5f;            // translation per shift-wheel notch
+	float wheelDegrees = 5;           // rotation about view axis per wheel notch
+	ArcCamera(int width, int height, vec3 rotation = vec3(0, 0, 0), vec3 translation = vec3(0, 0, -5),
+			  float fov = 30, float nearDist = .001f, float farDist = 500);
+	// mouse: screen coordinates as reported by GLFW (y increases downward)
+	void MouseDown(int x, int y);
+	void MouseDrag(int x, int y, bool shift = false);
+	void MouseUp();
+	void MouseWheel(bool forward, bool shift = false);
+	// view
+	void Resize(int width, int height);
+	float GetFOV() const { return fov; }
+	void SetFOV(float fov);
+	void SetRotation(Quat q);
+	void SetTranslation(vec3 t);
+	vec3 GetTranslation() const { return tranNew; }
+	// change tracking
+	int Changes() const { return changes; }
+	bool Changed(int &seen) const;    // true if view moved since seen, updates seen
+private:
+	int width, height, changes = 0;
+	float fov, nearDist, farDist;
+	vec2 mouseDown;
+	vec3 ballDown;                    // arcball point under MouseDown
+	Quat rotOld, rotNew;
+	vec3 tranOld, tranNew;
+	vec3 BallPoint(int x, int y) const;
+	void UpdatePersp();
+	void UpdateView();
+};
+
+#endif
@@ -0,0 +1,44 @@
+// DeferredShading.h
+// (c) Justin Thoreson
+// 19 October 2026
+// G-buffer and light-volume accumulation, for scenes with many point lights
+
+#ifndef DEFERREDSHADING_HDR
+#define DEFERREDSHADING_HDR
+
+#include <glad.h>
+#include <unordered_map>
+#include <vector>
+#include "GLState.h"
+#include "LightClusters.h"
+
+// DeferredShading
+//   geometry pass: between BeginGeometry and EndGeometry, scene shaders write
+//     pColor (albedo), gPosition (eye space) and gNormal (w = 1 if lit, else 0);
+//     call SetOutputs whenever such a program is bound
+//   Light draws to the current framebuffer: a full-screen pass copies unlit
+//     pixels, then each light adds a box volume (back faces, so the eye may be
+//     inside), shading only G-buffer pixels within the light's radius
+//   the sum of lights is clamped by the framebuffer, not before multiplying
+//   albedo as in the forward cube shader, so saturated pixels differ slightly
+
+class DeferredShading {
+public:
+	DeferredShading(int textureUnit = 5) : textureUnit(textureUnit) { }  // uses units textureUnit to +2
+	void Init(int width, int height);
+	void Resize(int width, int height);
+	void Release();
+	void BeginGeometry(GLState &state);
+	void SetOutputs(GLuint program);
+	void EndGeometry();
+	void Light(GLState &state, const std::vector<PointLight> &lights, mat4 persp);
+private:
+	int textureUnit, width = 0, height = 0;
+	GLuint framebuffer = 0, depth = 0, textures[3] = { 0 };  // position, normal, albedo
+	GLuint volumeBuffer = 0, volumeIndices = 0, composite = 0, volume = 0;
+	std::unordered_map<GLuint, std::vector<GLenum>> outputs;  // draw buffers per program
+	void MakeTargets();
+	void BindGBuffer(GLState &state, GLuint program);
+};
+
+#endif
@@ -0,0 +1,41 @@
+// Extrude.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Polygon triangulation and extrusion into indexed meshes, cached per outline
+
+#ifndef EXTRUDE_HDR
+#define EXTRUDE_HDR
+
+#include <vector>
+#include "Frustum.h"
+#include "VecMat.h"
+
+// Triangulate
+//   ear clipping of a simple polygon (no holes, either winding); triangles
+//   index outline and wind counter-clockwise in xy; collinear vertices are
+//   clipped without a triangle; false if no ear is found (self-intersecting)
+
+bool Triangulate(const std::vector<vec2> &outline, std::vector<int3> &triangles);
+
+// Extrude
+//   caps at z = -depth/2 (facing -z) and +depth/2 (facing +z), a wall per
+//   outline edge with its flat normal; vertices with equal position and
+//   normal are welded, so caps share vertices and collinear walls merge
+//   triangles wind counter-clockwise seen from outside; ready for a vertex
+//   buffer (points, normals) and an element buffer (triangles)
+//   ExtrudeCached returns the mesh for an outline and depth, extruding only
+//   the first time; ExtrudeOutlines places cached meshes (one per outline,
+//   a glyph of a string, say) at offsets and concatenates them
+
+struct ExtrudedMesh {
+	std::vector<vec3> points, normals;
+	std::vector<int3> triangles;
+	AABB bounds;
+};
+
+ExtrudedMesh Extrude(const std::vector<vec2> &outline, float depth);
+const ExtrudedMesh &ExtrudeCached(const std::vector<vec2> &outline, float depth);
+ExtrudedMesh ExtrudeOutlines(const std::vector<std::vector<vec2>> &outlines, const std::vector<vec2> &offsets, float depth);
+void PrintExtrudeStats(const char *title = NULL);
+
+#endif
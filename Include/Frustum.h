@@ -0,0 +1,59 @@
+// Frustum.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Bounding volumes and view frustum culling
+
+#ifndef FRUSTUM_HDR
+#define FRUSTUM_HDR
+
+#include <stddef.h>
+#include <vector>
+#include "VecMat.h"
+
+// Bounding Volumes
+
+struct Sphere {
+	vec3 center;
+	float radius;
+	Sphere(vec3 center = vec3(0, 0, 0), float radius = 0) : center(center), radius(radius) { }
+};
+
+struct AABB {
+	vec3 min, max;
+	AABB(vec3 min = vec3(0, 0, 0), vec3 max = vec3(0, 0, 0)) : min(min), max(max) { }
+	vec3 Center() const { return .5f * (min + max); }
+	vec3 Extent() const { return .5f * (max - min); }
+};
+
+AABB BoundingBox(const vec3 *points, int npoints);
+AABB BoundingBox(const std::vector<vec3> &points);
+Sphere BoundingSphere(const vec3 *points, int npoints);
+Sphere BoundingSphere(const std::vector<vec3> &points);
+
+// Frustum
+//   Set() extracts the six clip planes of a view matrix (eg, camera.fullview);
+//   objects are then tested in the space that matrix maps from, optionally
+//   through a per-object transform; planes are stored as four-wide columns so
+//   each test handles four planes per SSE instruction
+
+class Frustum {
+public:
+	bool enabled = true;              // if false, every test passes (but is still counted)
+	int submitted = 0, culled = 0;    // draw counts since ResetStats
+	void Set(mat4 view);
+	bool Visible(const Sphere &s);
+	bool Visible(const AABB &b);
+	bool Visible(mat4 m, const Sphere &local);
+	bool Visible(mat4 m, const AABB &local);
+	void ResetStats() { submitted = culled = 0; }
+	void PrintStats(const char *title = NULL) const;
+private:
+	// planes 0-5: left, right, bottom, top, near, far; 6 and 7 repeat plane 0
+	alignas(16) float nx[8], ny[8], nz[8], d[8];
+	alignas(16) float ax[8], ay[8], az[8];    // absolute plane normals, for boxes
+	bool Count(bool visible);
+	bool TestSphere(vec3 c, float r) const;
+	bool TestBox(vec3 c, vec3 e) const;
+};
+
+#endif
@@ -0,0 +1,19 @@
+// GLCount.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Per-frame count of GL calls by entrypoint, via wrapped glad function pointers
+
+#ifndef GLCOUNT_HDR
+#define GLCOUNT_HDR
+
+#include <stddef.h>
+
+// call GLCountInstall once after gladLoadGLLoader; until then (or if never
+// called) GL calls go straight to the driver and nothing is counted
+
+void GLCountInstall();
+void GLCountNewFrame();                    // call once per frame, after Display
+int GLCountFrameCalls();                   // total calls of previous frame
+void GLCountPrint(const char *title = NULL);  // previous frame and run average, by entrypoint
+
+#endif
@@ -0,0 +1,64 @@
+// GLState.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Shadow of GL state that filters redundant binds, enables and uniform writes
+
+#ifndef GLSTATE_HDR
+#define GLSTATE_HDR
+
+#include <glad.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "VecMat.h"
+
+// GLState
+//   each call is forwarded to GL only if it changes the shadowed value;
+//   calls made around the tracker (eg, by Draw.h or GLXtras helpers) leave the
+//   shadow stale, so follow them with Invalidate or InvalidateBuffer
+//   uniforms are cached per program and location: once written here, a
+//   uniform must only be written here (or its program relinked and Forget called)
+
+class GLState {
+public:
+	int issued = 0, elided = 0;              // calls this frame
+	int lastIssued = 0, lastElided = 0;      // calls previous frame
+	void NewFrame();
+	void PrintStats(const char *title = NULL) const;
+	void Invalidate();                        // forget binds and enables (keeps uniforms)
+	void InvalidateBuffer(GLenum target);
+	void InvalidateTextures();                // forget texture binds and active unit
+	void Forget(GLuint program);              // drop cached uniforms of program
+	// state
+	void Enable(GLenum cap);
+	void Disable(GLenum cap);
+	void BlendFunc(GLenum src, GLenum dst);
+	void UseProgram(GLuint program);
+	void BindBuffer(GLenum target, GLuint buffer);
+	void BindTexture(int unit, GLenum target, GLuint texture);
+	// uniforms of the current program
+	bool SetUniform(GLuint program, const char *name, bool b);
+	bool SetUniform(GLuint program, const char *name, int i);
+	bool SetUniform(GLuint program, const char *name, float f);
+	bool SetUniform(GLuint program, const char *name, vec3 v);
+	bool SetUniform(GLuint program, const char *name, vec3 *v, int count);
+	bool SetUniform(GLuint program, const char *name, mat4 m);
+private:
+	struct ProgramCache {
+		std::unordered_map<std::string, GLint> locations;
+		std::unordered_map<GLint, std::vector<char>> values;
+	};
+	std::unordered_map<GLenum, bool> caps;
+	std::unordered_map<GLenum, GLuint> buffers;
+	std::unordered_map<int, GLuint> textures;    // 2D-style binding per unit
+	std::unordered_map<GLuint, ProgramCache> programs;
+	GLuint program = 0;
+	int activeUnit = -1;
+	GLenum blendSrc = 0, blendDst = 0;
+	bool programKnown = false;
+	bool Changed(bool same);
+	GLint Location(GLuint program, const char *name);
+	bool NewValue(GLuint program, GLint loc, const void *data, int nBytes);
+};
+
+#endif
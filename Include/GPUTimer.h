@@ -0,0 +1,38 @@
+// GPUTimer.h
+// (c) Justin Thoreson
+// 19 October 2026
+// GPU time of a span of draws, read without waiting
+
+#ifndef GPUTIMER_HDR
+#define GPUTIMER_HDR
+
+#include <glad.h>
+#include <stddef.h>
+
+// GPUTimer
+//   a GL_TIME_ELAPSED query around a span of draws, at most once per frame;
+//   queries rotate through a ring of three and each result is read once
+//   available, a frame or two late, so the GPU is never waited on (a frame
+//   whose query slot is still busy goes untimed)
+//   only one GL_TIME_ELAPSED query may be active: timers cannot nest
+//   usage per frame: Begin, draws, End
+
+class GPUTimer {
+public:
+	float ms = 0;                         // most recent result
+	void Begin();
+	void End();
+	void Reset();                         // restart the average
+	float Average() const { return count ? (float) (sum / count) : 0; }
+	int Frames() const { return count; }
+	void Release();
+private:
+	GLuint queries[3] = { 0, 0, 0 };
+	bool issued[3] = { false, false, false };
+	bool active = false;
+	int next = 0, count = 0;
+	double sum = 0;
+	void Collect();
+};
+
+#endif
@@ -0,0 +1,89 @@
+// LightClusters.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Clustered forward lighting: point lights binned into a 3D grid over the view
+
+#ifndef LIGHTCLUSTERS_HDR
+#define LIGHTCLUSTERS_HDR
+
+#include <glad.h>
+#include <vector>
+#include "GLState.h"
+#include "VecMat.h"
+
+// point light in eye space; contributes nothing beyond radius
+struct PointLight {
+	vec3 position;
+	float radius = 1;
+	vec3 color = vec3(1);
+	PointLight(vec3 p = vec3(0), float r = 1, vec3 c = vec3(1)) : position(p), radius(r), color(c) { }
+};
+
+// LightClusters
+//   the view is divided into nx by ny screen tiles and nz depth slices,
+//   exponentially spaced from nearZ to farZ; Build bins each light into the
+//   clusters its bounding box overlaps and uploads three textures:
+//     clusterGrid (usampler3D):    per cluster, offset and count into indices
+//     clusterIndices (usampler2D): light indices, INDEX_ROW per row
+//     clusterLights (sampler2D):   per light, (position, radius) then color
+//   Use binds them (units textureUnit to textureUnit+2) and sets their
+//   uniforms, plus clusterScale and clusterBias, for a shader to find its
+//   cluster from gl_FragCoord and eye depth (see CLUSTER_LOOKUP); so Build's
+//   width and height are of the framebuffer (glfwGetFramebufferSize), not the
+//   window, which is smaller on HiDPI displays
+//   Build leaves its textures bound outside glState: follow with
+//   glState.InvalidateTextures()
+
+class LightClusters {
+public:
+	static const int INDEX_ROW = 1024;
+	int nx = 16, ny = 16, nz = 24;
+	int maxLights = 1024, maxIndices = 1 << 16;
+	float nearZ = .1f, farZ = 100;
+	int nLights = 0, assigned = 0, dropped = 0;  // last Build: lights, light/cluster pairs, pairs over maxIndices
+	LightClusters(int textureUnit = 2) : textureUnit(textureUnit) { }
+	void Init();
+	void Release();
+	void Build(const std::vector<PointLight> &lights, mat4 persp, int width, int height);
+	void Use(GLState &state, GLuint program);
+	void PrintStats(const char *title = NULL) const;
+private:
+	int textureUnit, width = 1, height = 1;
+	GLuint grid = 0, indices = 0, lightData = 0;
+	std::vector<unsigned int> cells, list;  // per cluster (offset, count); light indices
+	std::vector<vec4> texels;
+	int Slice(float depth) const;
+};
+
+// GLSL for clustered lighting (#version 130); after this, a shader calls
+//   ClusterLight(point, normal) for the summed color of the cluster's lights
+//   at an eye-space point, given a function Intensity(N, E, point, light)
+//   declared before it, as in the cube shader; if CLUSTER_SHADOW is defined,
+//   each light is also scaled by ClusterShadow(l, point, light) (see PointShadows.h)
+#define CLUSTER_LOOKUP \
+	"uniform usampler3D clusterGrid;\n" \
+	"uniform usampler2D clusterIndices;\n" \
+	"uniform sampler2D clusterLights;\n" \
+	"uniform vec3 clusterScale;       // fragment x, y and log depth to cluster\n" \
+	"uniform float clusterBias;\n" \
+	"vec3 ClusterLight(vec3 point, vec3 N) {\n" \
+	"	ivec3 dims = textureSize(clusterGrid, 0);\n" \
+	"	float z = log(max(-point.z, 1e-6))*clusterScale.z+clusterBias;\n" \
+	"	ivec3 c = clamp(ivec3(ivec2(gl_FragCoord.xy*clusterScale.xy), int(z)), ivec3(0), dims-1);\n" \
+	"	uvec2 cell = texelFetch(clusterGrid, c, 0).rg;\n" \
+	"	vec3 E = normalize(point), sum = vec3(0);\n" \
+	"	for (uint i = 0u; i < cell.y; i++) {\n" \
+	"		int k = int(cell.x+i);\n" \
+	"		int l = int(texelFetch(clusterIndices, ivec2(k%1024, k/1024), 0).r);\n" \
+	"		vec4 light = texelFetch(clusterLights, ivec2(2*l, 0), 0);\n" \
+	"		vec3 color = texelFetch(clusterLights, ivec2(2*l+1, 0), 0).rgb;\n" \
+	"		float d = length(light.xyz-point)/light.w, w = clamp(1-d*d*d*d, 0., 1.);\n" \
+	"#ifdef CLUSTER_SHADOW\n" \
+	"		w *= ClusterShadow(l, point, light.xyz);\n" \
+	"#endif\n" \
+	"		sum += w*w*color*Intensity(N, E, point, light.xyz);\n" \
+	"	}\n" \
+	"	return sum;\n" \
+	"}\n"
+
+#endif
@@ -0,0 +1,85 @@
+// MultiView.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Several viewports of one scene: culled once per object, drawn layered where supported
+
+#ifndef MULTIVIEW_HDR
+#define MULTIVIEW_HDR
+
+#include <glad.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Frustum.h"
+
+// MultiView
+//   a list of views (viewport and view-projection, eg split-screen or a
+//   stereo pair); each view's frustum is extracted only when its matrix
+//   changes, and Cull transforms an object's bounds to world space once,
+//   then tests it against every view, returning a mask of views that see it
+//   Draw emits an object into the views of a mask: with viewport arrays
+//   (GL 4.1, ARB_viewport_array) and layered enabled, as one instanced draw
+//   of layeredProgram, each instance a view (its matrix from views[], its
+//   viewport set by the geometry stage); otherwise once per view, with
+//   program, its viewport and its view uniform (uploaded only on change)
+//   draw(n) issues the caller's draw, n instances, program in use and
+//   attributes set for it
+//   layered shaders: the vertex shader (#version 410) includes
+//   MULTIVIEW_VERTEX, writes vColor and sets gl_Position from MultiView();
+//   MULTIVIEW_GEOMETRY passes vColor on as gColor
+
+#define MULTIVIEW_MAX 4
+
+#define MULTIVIEW_VERTEX \
+	"uniform mat4 views[4];\n" \
+	"uniform int viewIndex[4];\n" \
+	"flat out int vViewport;\n" \
+	"mat4 MultiView() {\n" \
+	"    vViewport = viewIndex[gl_InstanceID];\n" \
+	"    return views[gl_InstanceID];\n" \
+	"}\n"
+
+#define MULTIVIEW_GEOMETRY \
+	"#version 410\n" \
+	"layout (triangles) in;\n" \
+	"layout (triangle_strip, max_vertices = 3) out;\n" \
+	"flat in int vViewport[];\n" \
+	"in vec4 vColor[];\n" \
+	"out vec4 gColor;\n" \
+	"void main() {\n" \
+	"    for (int i = 0; i < 3; i++) {\n" \
+	"        gl_ViewportIndex = vViewport[0];\n" \
+	"        gl_Position = gl_in[i].gl_Position;\n" \
+	"        gColor = vColor[i];\n" \
+	"        EmitVertex();\n" \
+	"    }\n" \
+	"    EndPrimitive();\n" \
+	"}\n"
+
+struct View {
+	int x = 0, y = 0, width = 0, height = 0;  // viewport
+	mat4 viewProj;                             // eg, camera.fullview
+	View(int x = 0, int y = 0, int width = 0, int height = 0, mat4 viewProj = mat4())
+		: x(x), y(y), width(width), height(height), viewProj(viewProj) { }
+};
+
+class MultiView {
+public:
+	bool layered = true;                       // single instanced draw, if Supported
+	int layeredDraws = 0, viewDraws = 0;       // since ResetStats
+	void SetViews(const std::vector<View> &views);
+	int Views() const { return (int) views.size(); }
+	const View &GetView(int i) const { return views[i]; }
+	bool Supported() const;
+	unsigned Cull(mat4 model, const AABB &local);
+	void Viewport(int i) const;
+	void Draw(GLuint layeredProgram, GLuint program, mat4 model, unsigned mask, const std::function<void(int)> &draw);
+	void ResetStats();
+	void PrintStats(const char *title = NULL) const;
+private:
+	std::vector<View> views;
+	std::vector<Frustum> frusta;
+	std::vector<std::pair<GLuint, mat4>> uploaded;  // per program, last view uniform
+};
+
+#endif
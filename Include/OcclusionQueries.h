@@ -0,0 +1,44 @@
+// OcclusionQueries.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Occlusion queries read one frame late, to skip passes whose stand-in geometry was hidden
+
+#ifndef OCCLUSIONQUERIES_HDR
+#define OCCLUSIONQUERIES_HDR
+
+#include <glad.h>
+#include <stddef.h>
+#include <unordered_map>
+
+// OcclusionQueries
+//   one GL_ANY_SAMPLES_PASSED query per caller id (eg, a portal and the path
+//   of portals it is seen through); Begin and End bracket a cheap test draw of
+//   the stand-in (eg, portal disk) after the occluders are drawn
+//   Visible reports the test issued for id in the previous frame, so the GPU
+//   is never waited on: an id not tested last frame, or whose result is not
+//   yet available, is visible; a hidden result skips one frame late, so a
+//   pass may be missing for the frame in which its stand-in first appears
+//   usage per frame: NewFrame, {Visible(id), ..., occluders, Begin(id), draw, End}*
+
+class OcclusionQueries {
+public:
+	bool enabled = true;                     // if false, everything is visible (and nothing tested)
+	int skipped = 0, pending = 0;            // this frame: hidden results, results not yet available
+	int lastSkipped = 0, lastPending = 0;    // previous frame
+	long totalSkipped = 0;
+	void NewFrame();
+	bool Visible(int id);
+	void Begin(int id);
+	void End();
+	void Release();
+	void PrintStats(const char *title = NULL) const;
+private:
+	struct Query {
+		GLuint name = 0;
+		int frame = -1;                      // frame issued
+	};
+	std::unordered_map<int, Query> queries;
+	int frame = 0;
+};
+
+#endif
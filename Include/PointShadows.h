@@ -0,0 +1,69 @@
+// PointShadows.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Cube shadow maps for point lights, with static casters cached across frames
+
+#ifndef POINTSHADOWS_HDR
+#define POINTSHADOWS_HDR
+
+#include <glad.h>
+#include <functional>
+#include <vector>
+#include "Frustum.h"
+#include "GLState.h"
+#include "VecMat.h"
+
+// PointShadows
+//   each light has two depth cube maps, storing distance to light / farZ:
+//   a static layer, rendered only after the light moves or InvalidateStatic,
+//   and a dynamic layer, rendered every frame; a shader takes the nearer
+//   Render calls draw(face, dynamic) for each face to be rendered, with the
+//   depth program bound and its viewProj set; draw binds attributes, sets
+//   "model" (via Program) for each caster that face can see, and returns the
+//   number drawn
+//   Use binds the maps (units textureUnit to textureUnit+2*nLights-1) and sets
+//   the uniforms of SHADOW_LOOKUP
+
+class PointShadows {
+public:
+	int size = 512;
+	float nearZ = .05f, farZ = 20, bias = .01f;
+	int faces = 0, cachedFaces = 0, draws = 0;   // last Render
+	PointShadows(int nLights = 2, int textureUnit = 8) : nLights(nLights), textureUnit(textureUnit) { }
+	void Init();
+	void Release();
+	void SetLight(int i, vec3 world);            // moving a light invalidates its static layer
+	void InvalidateStatic();
+	GLuint Program() const { return program; }
+	void Render(GLState &state, std::function<int(Frustum &face, bool dynamic)> draw);
+	void Use(GLState &state, GLuint program);
+	void PrintStats(const char *title = NULL) const;
+private:
+	int nLights, textureUnit;
+	GLuint framebuffer = 0, program = 0;
+	std::vector<GLuint> maps;                    // static, dynamic per light
+	std::vector<vec3> lights;
+	std::vector<bool> staticValid;
+	Frustum frustum;
+};
+
+// GLSL for cube shadow lookup (#version 130), for two lights as used in
+// PortalIllusion; ClusterShadow(l, point, light) with eye-space point and
+// light, is 0 if light l is occluded at point, else 1 (1 for l > 1); defines
+// CLUSTER_SHADOW so that CLUSTER_LOOKUP, which must follow, applies it
+#define SHADOW_LOOKUP \
+	"uniform samplerCube shadowStatic0, shadowDynamic0, shadowStatic1, shadowDynamic1;\n" \
+	"uniform mat4 view;              // world to eye, rigid\n" \
+	"uniform float shadowFar, shadowBias;\n" \
+	"float ClusterShadow(int l, vec3 point, vec3 light) {\n" \
+	"	if (l > 1)\n" \
+	"		return 1.;\n" \
+	"	vec3 d = (point-light)*mat3(view);  // to world, by inverse rotation\n" \
+	"	float occluder = l == 0?\n" \
+	"		min(texture(shadowStatic0, d).r, texture(shadowDynamic0, d).r) :\n" \
+	"		min(texture(shadowStatic1, d).r, texture(shadowDynamic1, d).r);\n" \
+	"	return length(d)/shadowFar-shadowBias > occluder? 0. : 1.;\n" \
+	"}\n" \
+	"#define CLUSTER_SHADOW\n"
+
+#endif
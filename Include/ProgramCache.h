@@ -0,0 +1,49 @@
+// ProgramCache.h
+// (c) Justin Thoreson
+// 19 October 2026
+// On-disk cache of linked shader program binaries
+
+#ifndef PROGRAMCACHE_HDR
+#define PROGRAMCACHE_HDR
+
+#include <glad.h>
+#include <stddef.h>
+
+// LinkProgramCached
+//   same arguments as LinkProgramViaCode; the key hashes all stage sources with
+//   the GL vendor, renderer and version strings, so a driver update or source
+//   edit misses; a missing, stale or rejected binary falls back to compiling
+//   from source, after which the new binary is written to the cache
+
+void SetProgramCacheDirectory(const char *dir);   // default "ProgramCache"
+GLuint LinkProgramCached(const char **vCode, const char **pCode);
+GLuint LinkProgramCached(const char **vCode, const char **tcCode, const char **teCode,
+						 const char **gCode, const char **pCode);
+
+// LinkProgramCachedAsync
+//   issues the binary load, or the compile and link, and returns at once with
+//   the program name; nothing queries status until AwaitProgram, so programs
+//   compile while the caller loads textures and meshes
+//   AwaitProgram blocks until linked (a no-op once done) and returns program,
+//   which may be renamed if a cached binary was rejected, or 0 on failure
+//   ProgramReady polls without blocking if parallel compile is enabled, and is
+//   otherwise always true (the driver compiles when status is first queried)
+
+bool EnableParallelShaderCompile(GLADloadproc load);  // GL_KHR/ARB_parallel_shader_compile
+GLuint LinkProgramCachedAsync(const char **vCode, const char **pCode);
+GLuint LinkProgramCachedAsync(const char **vCode, const char **tcCode, const char **teCode,
+							  const char **gCode, const char **pCode);
+bool ProgramReady(GLuint program);
+GLuint AwaitProgram(GLuint &program);
+
+// timing of all programs linked so far
+struct ProgramCacheStats {
+	int hits = 0, misses = 0;
+	double hitMs = 0, missMs = 0;  // main-thread time, issue plus wait
+	double waitMs = 0;              // time blocked in AwaitProgram
+};
+
+ProgramCacheStats GetProgramCacheStats();
+void PrintProgramCacheStats(const char *title = NULL);
+
+#endif
@@ -0,0 +1,62 @@
+// ShaderReload.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Shader sources kept in files, watched and relinked while the app runs
+
+#ifndef SHADERRELOAD_HDR
+#define SHADERRELOAD_HDR
+
+#include <glad.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ShaderVariants.h"
+
+// ShaderReload
+//   Source returns the text of a file in the watched directory, first writing
+//   the embedded code there if the file is missing (so the code compiled into
+//   the app is the default, and the file is what gets edited); the pointer is
+//   valid until the file next changes
+//   Add registers a program, or a set of variants, with its two stage files
+//   a watcher thread (inotify on Linux, else modification times polled) reads
+//   each file saved; Poll, once per frame, issues relinks of the programs
+//   using it without waiting, and swaps each in once linked; a program that
+//   fails to compile or link is discarded and the previous one kept
+//   usage: Start, Source (for initial link), Add, then Poll per frame
+
+class ShaderReload {
+public:
+	std::function<void(GLuint)> retired;      // called for each program swapped out, before deletion
+	int reloads = 0, failures = 0;
+	~ShaderReload() { Stop(); }
+	bool Start(const char *dir);              // creates dir if need be
+	void Stop();
+	const char *Source(const char *file, const char *code);
+	void Add(GLuint *program, const char *vFile, const char *pFile);
+	void Add(ShaderVariants *variants, const char *vFile, const char *pFile);
+	int Poll();                               // programs swapped in
+private:
+	struct Target {
+		GLuint *program = NULL, next = 0;
+		ShaderVariants *variants = NULL;
+		std::string vFile, pFile;
+	};
+	std::string dir;
+	std::vector<Target> targets;
+	std::unordered_map<std::string, std::string> sources;   // file to text, main thread
+	std::unordered_map<std::string, long long> files;       // watched file to modification time
+	std::unordered_map<std::string, std::string> changed;   // read by watcher, taken by Poll
+	std::mutex mutex;                                       // guards files and changed
+	std::thread watcher;
+	std::atomic<bool> running{false};
+	std::string Path(const std::string &file) const { return dir + "/" + file; }
+	void Retire(GLuint program);
+	void Changed(const std::string &file);
+	void Watch();
+};
+
+#endif
@@ -0,0 +1,42 @@
+// ShaderVariants.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Shader programs specialized at compile time by #define flags
+
+#ifndef SHADERVARIANTS_HDR
+#define SHADERVARIANTS_HDR
+
+#include <glad.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ShaderVariants
+//   bit i of a key defines flags[i] (as 1) after the #version line of both
+//   stages, so the shader selects features with #ifdef rather than uniform
+//   branches; each key is linked once, through the program cache
+//   Prepare starts a link without waiting (call at startup for the keys a
+//   scene draws); Program returns the linked variant, waiting if necessary
+//   Reload replaces the sources: before any Prepare it simply sets them;
+//   after, it issues links of every prepared key without waiting, and Swap,
+//   polled once per frame, replaces all variants at once when all have
+//   linked, or keeps the current sources and programs if any failed
+
+class ShaderVariants {
+public:
+	ShaderVariants(const char *vCode, const char *pCode, std::vector<const char *> flags);
+	void Prepare(unsigned int key);
+	GLuint Program(unsigned int key);  // 0 if link failed
+	int Count() const { return (int) programs.size(); }
+	std::string Name(unsigned int key) const;  // eg, "TEXTURE|LIGHTING"
+	void Reload(const char *vCode, const char *pCode);
+	int Swap(std::vector<GLuint> &retired);   // 1: swapped (old programs added to retired), -1: failed, 0: none ready
+private:
+	std::string vCode, pCode, vNext, pNext;
+	std::vector<std::string> flags;
+	std::unordered_map<unsigned int, GLuint> programs, next;
+	void Discard();
+	std::string Specialize(const std::string &code, unsigned int key) const;
+};
+
+#endif
@@ -0,0 +1,47 @@
+// StreamBuffer.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Fence-synchronized ring buffer for dynamic per-frame data
+
+#ifndef STREAMBUFFER_HDR
+#define STREAMBUFFER_HDR
+
+#include <glad.h>
+#include <vector>
+
+// StreamBuffer
+//   buffer is split into one region per frame in flight (three by default);
+//   each frame suballocates from its region, which is reused only after the
+//   fence placed at the end of that frame has signaled
+//   persistent path: glBufferStorage, mapped once (coherent), draws read the
+//     mapping directly
+//   fallback: buffer is orphaned each frame, Alloc writes into a CPU copy and
+//     Commit uploads what was written since the last Commit
+//   usage per frame: BeginFrame, {Alloc, write, Commit, draw}*, EndFrame
+
+class StreamBuffer {
+public:
+	int stalls = 0;                   // frames that had to wait on the GPU
+	StreamBuffer(GLenum target = GL_ARRAY_BUFFER, int bytesPerFrame = 1 << 16, int nFrames = 3);
+	~StreamBuffer();
+	bool Init();                      // call with context current
+	void Release();
+	void BeginFrame();
+	void *Alloc(int nBytes, GLintptr &offset, int align = 16);  // NULL if region full
+	void Commit();
+	void EndFrame();
+	GLuint Buffer() const { return buffer; }
+	bool Persistent() const { return persistent; }
+	int Used() const { return head; } // bytes allocated this frame
+private:
+	GLenum target;
+	GLuint buffer = 0;
+	int bytesPerFrame, nFrames, frame = 0, head = 0, committed = 0;
+	bool persistent = false;
+	char *mapped = NULL;              // persistent mapping of whole buffer
+	std::vector<char> staging;        // fallback frame copy
+	std::vector<GLsync> fences;
+	GLintptr RegionStart() const { return persistent ? (GLintptr) frame * bytesPerFrame : 0; }
+};
+
+#endif
@@ -0,0 +1,87 @@
+// TextRenderer.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Glyph geometry cache and batched text, drawn as one instanced draw per frame
+
+#ifndef TEXTRENDERER_HDR
+#define TEXTRENDERER_HDR
+
+#include <glad.h>
+#include <unordered_map>
+#include <vector>
+#include "Frustum.h"
+#include "StreamBuffer.h"
+#include "VecMat.h"
+
+// TextRenderer
+//   glyphs for ASCII 32-126 are built once from a 5x7 block font: lit cells
+//   are merged into rectangles, colored by a gradient across the glyph box
+//   (red, magenta, cyan, yellow corners); AddGlyph registers others, or
+//   replaces a built-in, from an indexed mesh with per-vertex colors (the
+//   points may be a table shared by several glyphs: bounds cover only the
+//   points the glyph's triangles use)
+//   glyphs are stored as triangle lists padded (degenerate) to the longest,
+//   in one buffer texture; each queued glyph is an instance (transform,
+//   tint, glyph slot) in a streamed buffer, and the vertex shader pulls its
+//   vertices by gl_VertexID, so any mix of glyphs is one instanced draw
+//   sdf: glyphs instead drawn as 4-vertex quads sampling a distance field
+//   atlas (smoothstep at the edge, so sharp at any scale), generated on the
+//   CPU across hardware threads the first time it is needed after glyphs
+//   change; each glyph's texels and quad (box, per instance) cover its
+//   bounds plus the field's spread, and the atlas holds the color of the
+//   nearest mesh point, so quads match the meshes (times tint)
+//   sdf blends the quads; End restores the caller's blend enable and function
+//   glyph space: height 1, baseline at y = 0, left edge at x = 0
+//   usage per frame: Begin, {Glyph, Text}*, End(view); End binds the glyph
+//   buffer texture on textureUnit: follow with GLState::InvalidateTextures
+
+class TextRenderer {
+public:
+	bool sdf = false;                                   // distance field quads, else glyph meshes
+	TextRenderer(int textureUnit = 0, int maxGlyphs = 1 << 14);
+	bool Init();                                        // call with context current
+	void Release();
+	void AddGlyph(int code, const vec3 *points, const vec3 *colors, int nPoints,
+				  const int3 *triangles, int nTriangles, float advance);
+	float Advance(int code) const;
+	float Width(const char *s) const;
+	AABB Bounds(const char *s) const;                   // in text space
+	mat4 Center(const char *s) const;                   // moves text center to origin
+	void Begin();
+	void Glyph(int code, mat4 m, vec3 tint = vec3(1, 1, 1));
+	void Text(const char *s, mat4 m, vec3 tint = vec3(1, 1, 1));
+	void End(mat4 view);                                // draws everything queued since Begin
+	void PrintStats(const char *title = NULL) const;
+private:
+	struct Mesh {
+		std::vector<vec3> points, colors;               // triangle list
+		float advance = 0;
+		AABB bounds;
+		int fieldWidth = 0, fieldHeight = 0;            // sdf: atlas texels
+		vec4 box;                                       // sdf: glyph space they cover
+	};
+	struct Instance {
+		float rows[4][4];                               // transform, row-major
+		float tint[4];                                  // rgb, glyph slot
+		float box[4];                                   // sdf quad, glyph space
+	};
+	std::vector<Mesh> meshes;
+	std::unordered_map<int, int> slots;                 // code to mesh
+	std::vector<Instance> instances;
+	StreamBuffer stream;
+	int textureUnit, maxGlyphs, maxVertices = 0, lastGlyphs = 0, lastDraws = 0;
+	GLuint programs[2] = { 0, 0 }, vertexBuffer = 0, vertexTexture = 0;  // mesh, sdf
+	GLint attributes[2][6] = { { -1, -1, -1, -1, -1, -1 }, { -1, -1, -1, -1, -1, -1 } };  // row0-3, tint, box
+	bool stale = true;
+	// distance field atlas
+	GLuint atlas = 0;
+	int atlasWidth = 0, atlasHeight = 0, cellWidth = 0, cellHeight = 0;
+	double atlasMs = 0;
+	bool atlasStale = true;
+	const Mesh *Find(int code) const;
+	void BuildFont();
+	void UploadGlyphs();
+	void BuildAtlas();
+};
+
+#endif
@@ -0,0 +1,101 @@
+// TextureCache.h
+// (c) Justin Thoreson
+// 19 October 2026
+// On-disk cache of decoded textures with prebuilt mip levels, optionally block compressed
+
+#ifndef TEXTURECACHE_HDR
+#define TEXTURECACHE_HDR
+
+#include <glad.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// LoadTextureCached
+//   same arguments as LoadTexture, plus compress and sampling; the first load
+//   of an image decodes it (DecodeImage, on the CPU; through LoadTexture if
+//   it can't, or for MIP_GPU levels), builds every mip level, optionally
+//   encodes them as BC1 (S3TC DXT1, 4 bits per texel, where the
+//   driver supports it), and writes a container keyed by path, size and
+//   modification time of the image and the mip filter; later loads
+//   memory-map the container and upload it level by level, with no decode
+//   or mip generation
+
+// MipFilter
+//   Box: 2x2 average; Kaiser: separable Kaiser-windowed sinc, 8 taps per
+//   axis, sharper at distance with little ringing (clamped); both run on the
+//   CPU across hardware threads, wrapping at edges as GL_REPEAT samples
+//   GPU: glGenerateMipmap (the driver's filter, usually box), then read back
+
+enum MipFilter { MIP_BOX, MIP_KAISER, MIP_GPU };
+
+// TextureSampling
+//   per texture: trilinear across the levels by default; anisotropy > 1 adds
+//   anisotropic filtering (EXT/ARB_texture_filter_anisotropic), clamped to
+//   the driver maximum and ignored where unsupported; mipmaps false samples
+//   the base level only, bilinear (the cost the chain saves, for comparison)
+
+struct TextureSampling {
+	bool mipmaps;
+	float anisotropy;
+	TextureSampling(bool mipmaps = true, float anisotropy = 8) : mipmaps(mipmaps), anisotropy(anisotropy) { }
+};
+
+void SetTextureCacheDirectory(const char *dir);   // default "TextureCache"
+void SetMipFilter(MipFilter filter);              // default MIP_KAISER; for textures converted after
+MipFilter GetMipFilter();
+GLuint LoadTextureCached(const char *filename, int textureUnit = 0, bool compress = false, TextureSampling sampling = TextureSampling());
+void SetTextureSampling(GLenum target, TextureSampling sampling);  // texture bound on active unit
+float MaxTextureAnisotropy();                                        // 1 if unsupported
+
+// steps of LoadTextureCached, for loaders that split them across threads
+bool TextureCompressionSupported();                                  // BC1; context current
+std::string TextureCachePath(const char *filename, bool compress);   // any thread
+bool DecodeImage(const char *filename, std::vector<unsigned char> &rgba, int &width, int &height);  // any thread; RGBA8, bottom row first (stb_image 2.26+)
+bool ConvertImage(const std::vector<unsigned char> &rgba, int width, int height, bool compress, const char *path);  // any thread; false for MIP_GPU
+bool ConvertTexture(const char *filename, int textureUnit, bool compress, const char *path);  // context current
+void AddTextureCacheStats(bool hit, double ms, long long gpuBytes);
+
+// MappedFile
+//   read-only mapping of a whole file (mmap, or a file mapping on Windows);
+//   pages are read from disk as first touched
+
+class MappedFile {
+public:
+	const char *data = NULL;
+	size_t size = 0;
+	~MappedFile() { Close(); }
+	bool Open(const char *path);
+	void Close();
+private:
+	void *mapping = NULL;              // platform handle
+};
+
+// TextureFile
+//   a mapped container: each level is a pointer into the mapping, ready for
+//   glTexImage2D (GL_RGBA8) or glCompressedTexImage2D (BC1)
+
+class TextureFile {
+public:
+	int width = 0, height = 0, levels = 0;
+	GLenum format = 0;                 // GL_RGBA8 or GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	~TextureFile() { Close(); }
+	bool Open(const char *path);
+	void Close();
+	const void *Level(int level, int &w, int &h, int &nBytes) const;
+	int Bytes() const;                 // all levels
+private:
+	MappedFile file;
+};
+
+// timing of all textures loaded so far
+struct TextureCacheStats {
+	int hits = 0, misses = 0;
+	double hitMs = 0, missMs = 0;      // load and upload, including conversion on a miss
+	long long gpuBytes = 0;            // all levels uploaded
+};
+
+TextureCacheStats GetTextureCacheStats();
+void PrintTextureCacheStats(const char *title = NULL);
+
+#endif
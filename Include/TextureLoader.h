@@ -0,0 +1,78 @@
+// TextureLoader.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Textures loaded on worker threads and uploaded in slices per frame, through a pixel buffer
+
+#ifndef TEXTURELOADER_HDR
+#define TEXTURELOADER_HDR
+
+#include <glad.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StreamBuffer.h"
+#include "TextureCache.h"
+#include "VecMat.h"
+
+// TextureLoader
+//   Load returns at once with a texture holding a 1x1 placeholder; a worker
+//   maps the texture's cache container (see TextureCache) and faults its
+//   pages in, first converting the image if not yet cached (decode, mip
+//   levels and BC1 encoding all on the worker); Update, once per frame,
+//   then uploads at most bytesPerFrame
+//   through a streamed pixel unpack buffer, coarsest level first, lowering
+//   GL_TEXTURE_BASE_LEVEL as each level completes, so the texture sharpens
+//   over a few frames rather than stalling startup; sampling (see
+//   TextureCache) is set on the placeholder and holds through the upload
+//   Update converts on the main thread, one per frame, only what a worker
+//   can't: an image the CPU decoder doesn't read (decoded by LoadTexture) or
+//   MIP_GPU levels; if the cache can't be written, the image is uploaded
+//   uncached at once, mips by glGenerateMipmap
+//   Update binds textures and changes the active unit: if it returns true,
+//   follow with GLState::InvalidateTextures (or rebind)
+
+class TextureLoader {
+public:
+	TextureLoader(int bytesPerFrame = 1 << 20, int nWorkers = 2);
+	~TextureLoader();
+	bool Init();                                   // call with context current
+	void Release();
+	GLuint Load(const char *filename, int textureUnit = 0, bool compress = false, vec3 placeholder = vec3(.5f, .5f, .5f),
+				TextureSampling sampling = TextureSampling());
+	bool Update();                                 // true if any GL texture state changed
+	bool Busy();                                   // loads not yet complete
+	bool Loading(GLuint texture) const;            // texture's load not yet complete
+	int Pending() const { return (int) jobs.size(); }
+	void PrintStats(const char *title = NULL) const;
+private:
+	enum State { Queued, Mapped, Decoded, Missing, Uploading, Done };
+	struct Job {
+		std::string filename, path;
+		GLuint texture = 0;
+		int unit = 0, level = 0, row = 0;          // next upload
+		bool compress = false, hit = true;
+		State state = Queued;
+		TextureFile file;
+		std::vector<unsigned char> rgba;           // decoded but not cached: level 0, for Update
+		int width = 0, height = 0;
+		double ms = 0;                             // worker and upload time
+	};
+	std::vector<Job *> jobs;                       // owned; main thread, except state and file
+	std::deque<Job *> queue;                       // for workers
+	std::mutex mutex;                              // guards queue and job states
+	std::condition_variable wake;
+	std::vector<std::thread> workers;
+	bool stopping = false;
+	StreamBuffer pixels;
+	int bytesPerFrame, nWorkers, frames = 0, loaded = 0;
+	long long uploaded = 0;
+	void Work();
+	void Start(Job *job);
+	void UploadUncached(Job *job);
+	int Slice(Job *job, int budget);
+};
+
+#endif
@@ -0,0 +1,141 @@
+// VirtualTexture.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Tiled mip pyramid streamed on demand into a physical atlas, by GPU feedback
+
+#ifndef VIRTUALTEXTURE_HDR
+#define VIRTUALTEXTURE_HDR
+
+#include <glad.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StreamBuffer.h"
+#include "TextureCache.h"
+
+// BuildVirtualTexture
+//   writes a tile file: the image's mip pyramid cut into pages of
+//   VT_CONTENT texels square, each stored as a VT_TILE square RGBA8 tile
+//   with a VT_BORDER texel border copied from its neighbors (wrapped in u,
+//   clamped in v), so bilinear lookups near a page edge stay in the tile
+//   images is a row-major grid of equal sized sources, columns wide, so the
+//   whole need never be in memory at once: each source is decoded on the CPU
+//   (DecodeImage, so no GL_MAX_TEXTURE_SIZE limit) and written into the
+//   level 0 tiles it overlaps; coarser levels are box filtered from the
+//   tiles below them
+
+bool BuildVirtualTexture(const std::vector<std::string> &images, int columns, const char *path);
+bool BuildVirtualTexture(const char *image, const char *path);
+
+// VirtualTexture
+//   Init maps a tile file and allocates a physical atlas of budgetMB (tile
+//   slots, least recently used evicted; 64 MB holds 32x32 tiles) and an indirection texture
+//   with one entry per page of every level, stacked vertically: atlas slot
+//   and level of the finest resident page covering it, so a missing page
+//   samples its nearest resident ancestor
+//   each frame: Update (consumes the previous frame's feedback, uploads
+//   loaded tiles, rebuilds indirection), then BeginFeedback, draw with a
+//   program writing VirtualFeedback(uv) to an unsigned integer target,
+//   EndFeedback (reads back asynchronously), then draw with Use
+//   shaders include VT_LOOKUP (and VT_FEEDBACK for the feedback pass)
+//   Update, Use and the feedback pass bind textures and buffers: follow with
+//   GLState::InvalidateTextures (or rebind)
+
+#define VT_TILE 128
+#define VT_BORDER 4
+#define VT_CONTENT (VT_TILE-2*VT_BORDER)
+
+#define VT_LOOKUP \
+	"uniform usampler2D vtIndirection;\n" \
+	"uniform sampler2D vtAtlas;\n" \
+	"uniform ivec2 vtSize;\n" \
+	"uniform int vtLevels, vtAtlasTiles;\n" \
+	"uniform float vtBias;\n" \
+	"const int VT_TILE = 128, VT_BORDER = 4, VT_CONTENT = 120;\n" \
+	"ivec2 VirtualLevelSize(int l) { return max(vtSize >> l, ivec2(1)); }\n" \
+	"ivec2 VirtualPages(int l) { return (VirtualLevelSize(l)+VT_CONTENT-1)/VT_CONTENT; }\n" \
+	"ivec2 VirtualPageOf(vec2 t, int l) { return min(ivec2(t)/VT_CONTENT, VirtualPages(l)-1); }\n" \
+	"ivec3 VirtualPage(vec2 uv) {\n" \
+	"    // level from screen-space footprint (before fract, so repeats don't jump)\n" \
+	"    vec2 t = uv*vec2(vtSize), dx = dFdx(t), dy = dFdy(t);\n" \
+	"    float d = max(dot(dx, dx), dot(dy, dy));\n" \
+	"    int l = clamp(int(floor(.5*log2(max(d, 1e-8))+vtBias)), 0, vtLevels-1);\n" \
+	"    return ivec3(VirtualPageOf(fract(uv)*vec2(VirtualLevelSize(l)), l), l);\n" \
+	"}\n" \
+	"vec4 VirtualTexture(vec2 uv) {\n" \
+	"    ivec3 p = VirtualPage(uv);\n" \
+	"    int row = p.y;\n" \
+	"    for (int l = 0; l < p.z; l++)\n" \
+	"        row += VirtualPages(l).y;\n" \
+	"    uvec4 e = texelFetch(vtIndirection, ivec2(p.x, row), 0);\n" \
+	"    if (e.w == 0u)\n" \
+	"        return vec4(.5, .5, .5, 1.);\n" \
+	"    // e: atlas slot and level of finest resident page here\n" \
+	"    int l = int(e.z);\n" \
+	"    vec2 t = fract(uv)*vec2(VirtualLevelSize(l));\n" \
+	"    vec2 a = vec2(e.xy*uint(VT_TILE))+float(VT_BORDER)+t-vec2(VirtualPageOf(t, l)*VT_CONTENT);\n" \
+	"    return textureLod(vtAtlas, a/float(vtAtlasTiles*VT_TILE), 0.);\n" \
+	"}\n"
+
+#define VT_FEEDBACK \
+	"uvec4 VirtualFeedback(vec2 uv) { return uvec4(VirtualPage(uv), 1); }\n"
+
+// one level of the pyramid: its pages, first page in the file, first indirection row
+struct VirtualLevel { int width, height, pagesX, pagesY, first, row; };
+
+class VirtualTexture {
+public:
+	VirtualTexture(int atlasUnit = 1, int indirectionUnit = 2, int feedbackScale = 8);
+	~VirtualTexture();
+	bool Init(const char *path, int budgetMB = 64);  // call with context current
+	void Release();
+	void Update();
+	void BeginFeedback(int width, int height);     // window size; binds feedback framebuffer, viewport
+	void EndFeedback();                            // restores framebuffer 0 and viewport
+	void Use(GLuint program, bool feedbackPass = false);  // program in use
+	int Resident() const;
+	void PrintStats(const char *title = NULL) const;
+private:
+	std::vector<VirtualLevel> levels;
+	MappedFile file;
+	int width = 0, height = 0, nPages = 0;
+	// residency, per page
+	std::vector<int> slot, lastUsed;               // slot -1: not resident
+	std::vector<char> queued;
+	// atlas, per slot
+	std::vector<int> slotPage;                     // -1: free
+	int atlasTiles = 0, atlasUnit, indirectionUnit;
+	GLuint atlas = 0, indirection = 0;
+	std::vector<unsigned char> table;              // indirection texels, RGBA8UI
+	bool stale = true;
+	// feedback
+	int feedbackScale, fbWidth = 0, fbHeight = 0, frame = 0;
+	GLuint framebuffer = 0, feedback = 0, depth = 0, readback[2] = { 0, 0 };
+	bool readPending[2] = { false, false };
+	GLint viewport[4];
+	std::vector<int> requested;                    // frame of last request, per page
+	// tile loads: worker faults the tile in and copies it out
+	struct Tile { int page; std::vector<unsigned char> rgba; };
+	std::deque<int> loads;
+	std::deque<Tile> loaded;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::thread worker;
+	bool stopping = false;
+	StreamBuffer pixels;
+	// stats
+	int lastRequested = 0, uploads = 0, evictions = 0, dropped = 0;
+	void Work();
+	void Stop();
+	int PageIndex(int level, int x, int y) const { return levels[level].first + y * levels[level].pagesX + x; }
+	bool Request(int level, int x, int y, std::vector<int> &missing);
+	void ReadFeedback();
+	void Upload();
+	int FreeSlot();
+	void RebuildIndirection();
+};
+
+#endif
@@ -0,0 +1,68 @@
+// Wireframe.h
+// (c) Justin Thoreson
+// 19 October 2026
+// Unique-edge line wireframes, and a barycentric solid+wire shading pass
+
+#ifndef WIREFRAME_HDR
+#define WIREFRAME_HDR
+
+#include <glad.h>
+#include <vector>
+#include "VecMat.h"
+
+// UniqueEdges
+//   index pairs, each triangle edge once in first-seen order; given points,
+//   vertices at equal positions (eg, welded cap and wall copies) count as one
+
+std::vector<int> UniqueEdges(const int3 *triangles, int nTriangles, const vec3 *points = NULL, int nPoints = 0);
+
+// Wireframe
+//   Init builds an element buffer of unique edges, so Draw is one GL_LINES
+//   draw with the caller's program and vertex attributes; Draw leaves its
+//   element buffer bound
+
+class Wireframe {
+public:
+	bool Init(const int3 *triangles, int nTriangles, const vec3 *points = NULL, int nPoints = 0);
+	void Release();
+	void Draw();
+	int Edges() const { return nEdges; }
+private:
+	GLuint edgeBuffer = 0;
+	int nEdges = 0;
+};
+
+// WIRE_GEOMETRY, WIRE_SHADE
+//   solid and wire in one pass, no line primitives: the geometry stage gives
+//   each triangle corner a barycentric coordinate, and WireShade blends
+//   wireColor over color where any coordinate is within wireWidth pixels of 0
+//   the vertex shader writes vColor (vec4); the pixel shader (#version 150)
+//   reads gColor and includes WIRE_SHADE
+
+#define WIRE_GEOMETRY \
+	"#version 150\n" \
+	"layout (triangles) in;\n" \
+	"layout (triangle_strip, max_vertices = 3) out;\n" \
+	"in vec4 vColor[];\n" \
+	"out vec4 gColor;\n" \
+	"out vec3 gBary;\n" \
+	"void main() {\n" \
+	"    for (int i = 0; i < 3; i++) {\n" \
+	"        gl_Position = gl_in[i].gl_Position;\n" \
+	"        gColor = vColor[i];\n" \
+	"        gBary = vec3(i == 0, i == 1, i == 2);\n" \
+	"        EmitVertex();\n" \
+	"    }\n" \
+	"    EndPrimitive();\n" \
+	"}\n"
+
+#define WIRE_SHADE \
+	"in vec3 gBary;\n" \
+	"uniform float wireWidth = 1.5;\n" \
+	"uniform vec4 wireColor = vec4(0, 0, 0, 1);\n" \
+	"vec4 WireShade(vec4 color) {\n" \
+	"    vec3 a = smoothstep(vec3(0), fwidth(gBary)*wireWidth, gBary);\n" \
+	"    return mix(wireColor, color, min(min(a.x, a.y), a.z));\n" \
+	"}\n"
+
+#endif
@@ -0,0 +1,138 @@
+// ArcCamera.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <math.h>
+#include "ArcCamera.h"
+
+// Quaternion
+
+Quat::Quat(vec3 axis, float degrees) {
+	float len = length(axis), halfRad = .5f * degrees * 3.1415926f / 180.f;
+	float s = len > 0 ? sin(halfRad) / len : 0;
+	x = s * axis.x, y = s * axis.y, z = s * axis.z, w = cos(halfRad);
+}
+
+Quat Quat::operator*(const Quat &q) const {
+	return Quat(w*q.x + x*q.w + y*q.z - z*q.y,
+				w*q.y - x*q.z + y*q.w + z*q.x,
+				w*q.z + x*q.y - y*q.x + z*q.w,
+				w*q.w - x*q.x - y*q.y - z*q.z);
+}
+
+Quat Quat::Normalized() const {
+	float len = sqrt(x*x + y*y + z*z + w*w);
+	return len > 0 ? Quat(x/len, y/len, z/len, w/len) : Quat();
+}
+
+mat4 Quat::GetMatrix() const {
+	float xx = x*x, yy = y*y, zz = z*z, xy = x*y, xz = x*z, yz = y*z, wx = w*x, wy = w*y, wz = w*z;
+	return mat4(vec4(1-2*(yy+zz), 2*(xy-wz), 2*(xz+wy), 0),
+				vec4(2*(xy+wz), 1-2*(xx+zz), 2*(yz-wx), 0),
+				vec4(2*(xz-wy), 2*(yz+wx), 1-2*(xx+yy), 0),
+				vec4(0, 0, 0, 1));
+}
+
+// Arcball Camera
+
+ArcCamera::ArcCamera(int width, int height, vec3 rotation, vec3 translation, float fov, float nearDist, float farDist)
+	: width(width), height(height), fov(fov), nearDist(nearDist), farDist(farDist) {
+	// initial rotation given as degrees about x, then y, then z
+	rotOld = rotNew = Quat(vec3(0, 0, 1), rotation.z) * Quat(vec3(0, 1, 0), rotation.y) * Quat(vec3(1, 0, 0), rotation.x);
+	tranOld = tranNew = translation;
+	UpdatePersp();
+	UpdateView();
+}
+
+vec3 ArcCamera::BallPoint(int x, int y) const {
+	// map screen point onto unit sphere centered in window (Shoemake)
+	float radius = .5f * (float)(width < height ? width : height);
+	if (radius <= 0)
+		return vec3(0, 0, 1);
+	vec3 p((x - .5f * width) / radius, (.5f * height - y) / radius, 0);
+	float d2 = p.x * p.x + p.y * p.y;
+	if (d2 > 1)
+		return p / sqrt(d2);
+	p.z = sqrt(1 - d2);
+	return p;
+}
+
+void ArcCamera::MouseDown(int x, int y) {
+	mouseDown = vec2((float)x, (float)y);
+	ballDown = BallPoint(x, y);
+}
+
+void ArcCamera::MouseDrag(int x, int y, bool shift) {
+	if (shift) {
+		vec2 dif = vec2((float)x, (float)y) - mouseDown;
+		tranNew = tranOld + tranSpeed * vec3(dif.x, -dif.y, 0);
+	}
+	else {
+		// rotation taking ballDown to current ball point, applied in view space
+		vec3 b = BallPoint(x, y), axis = cross(ballDown, b);
+		float d = dot(ballDown, b);
+		if (d <= -.9999f)
+			return;
+		Quat drag = Quat(axis.x, axis.y, axis.z, 1 + d).Normalized();
+		rotNew = (drag * rotOld).Normalized();
+	}
+	UpdateView();
+}
+
+void ArcCamera::MouseUp() {
+	rotOld = rotNew;
+	tranOld = tranNew;
+}
+
+void ArcCamera::MouseWheel(bool forward, bool shift) {
+	if (shift)
+		tranNew.z += forward ? -zoomSpeed : zoomSpeed;
+	else
+		rotNew = (Quat(vec3(0, 0, 1), forward ? wheelDegrees : -wheelDegrees) * rotNew).Normalized();
+	rotOld = rotNew;
+	tranOld = tranNew;
+	UpdateView();
+}
+
+void ArcCamera::Resize(int w, int h) {
+	width = w;
+	height = h;
+	UpdatePersp();
+	UpdateView();
+}
+
+void ArcCamera::SetFOV(float f) {
+	fov = f;
+	UpdatePersp();
+	UpdateView();
+}
+
+void ArcCamera::SetRotation(Quat q) {
+	rotOld = rotNew = q.Normalized();
+	UpdateView();
+}
+
+void ArcCamera::SetTranslation(vec3 t) {
+	tranOld = tranNew = t;
+	UpdateView();
+}
+
+bool ArcCamera::Changed(int &seen) const {
+	if (seen == changes)
+		return false;
+	seen = changes;
+	return true;
+}
+
+void ArcCamera::UpdatePersp() {
+	float aspectRatio = height > 0 ? (float)width / (float)height : 1;
+	persp = Perspective(fov, aspectRatio, nearDist, farDist);
+}
+
+void ArcCamera::UpdateView() {
+	rot = rotNew.GetMatrix();
+	tran = Translate(tranNew);
+	modelview = tran * rot;
+	fullview = persp * modelview;
+	changes++;
+}
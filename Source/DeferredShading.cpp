@@ -0,0 +1,203 @@
+// DeferredShading.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include "DeferredShading.h"
+#include "GLXtras.h"
+#include "ProgramCache.h"
+
+// Shaders
+
+static const char *compositeVShader = R"(
+	#version 130
+	void main() {
+		// full-screen triangle
+		vec2 p = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID & 2) * 2 - 1);
+		gl_Position = vec4(p, 0, 1);
+	}
+)";
+
+static const char *compositePShader = R"(
+	#version 130
+	uniform sampler2D gNormal, gAlbedo;
+	out vec4 pColor;
+	void main() {
+		ivec2 p = ivec2(gl_FragCoord.xy);
+		bool lit = texelFetch(gNormal, p, 0).w > 0;
+		pColor = vec4(lit ? vec3(0) : texelFetch(gAlbedo, p, 0).rgb, 1);
+	}
+)";
+
+static const char *volumeVShader = R"(
+	#version 130
+	in vec3 point;
+	uniform vec4 light;                 // eye-space position, radius
+	uniform mat4 persp;
+	void main() {
+		gl_Position = persp*vec4(light.xyz+light.w*point, 1);
+	}
+)";
+
+static const char *volumePShader = R"(
+	#version 130
+	uniform sampler2D gPosition, gNormal, gAlbedo;
+	uniform vec4 light;
+	uniform vec3 color;
+	out vec4 pColor;
+	float Intensity(vec3 normalV, vec3 eyeV, vec3 point, vec3 light) {
+		vec3 lightV = normalize(light-point);
+		vec3 reflectV = reflect(lightV, normalV);
+		float d = max(0, dot(normalV, lightV));
+		float s = max(0, dot(reflectV, eyeV));
+		return clamp(d+pow(s, 50), 0, 1);
+	}
+	void main() {
+		ivec2 p = ivec2(gl_FragCoord.xy);
+		vec4 n = texelFetch(gNormal, p, 0);
+		vec3 point = texelFetch(gPosition, p, 0).xyz;
+		float d = length(light.xyz-point)/light.w;
+		if (n.w == 0 || d >= 1)
+			discard;
+		float w = clamp(1-d*d*d*d, 0, 1);
+		vec3 albedo = texelFetch(gAlbedo, p, 0).rgb;
+		pColor = vec4(w*w*color*albedo*Intensity(normalize(n.xyz), normalize(point), point, light.xyz), 1);
+	}
+)";
+
+// Targets
+
+void DeferredShading::MakeTargets() {
+	GLenum formats[] = { GL_RGBA16F, GL_RGBA16F, GL_RGBA8 };
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	for (int i = 0; i < 3; i++) {
+		glActiveTexture(GL_TEXTURE0 + textureUnit + i);
+		glBindTexture(GL_TEXTURE_2D, textures[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, formats[i], width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, textures[i], 0);
+	}
+	glActiveTexture(GL_TEXTURE0);
+	glBindRenderbuffer(GL_RENDERBUFFER, depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		printf("G-buffer incomplete\n");
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void DeferredShading::Init(int w, int h) {
+	width = w;
+	height = h;
+	glGenFramebuffers(1, &framebuffer);
+	glGenRenderbuffers(1, &depth);
+	glGenTextures(3, textures);
+	MakeTargets();
+	// unit box, triangles ccw from outside
+	float corners[8][3];
+	for (int k = 0; k < 8; k++)
+		for (int a = 0; a < 3; a++)
+			corners[k][a] = k & (1 << a) ? 1.f : -1.f;
+	GLushort faces[] = { 0,4,6, 0,6,2,  1,3,7, 1,7,5,  0,1,5, 0,5,4,  2,6,7, 2,7,3,  0,2,3, 0,3,1,  4,5,7, 4,7,6 };
+	glGenBuffers(1, &volumeBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, volumeBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	glGenBuffers(1, &volumeIndices);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, volumeIndices);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(faces), faces, GL_STATIC_DRAW);
+	composite = LinkProgramCachedAsync(&compositeVShader, &compositePShader);
+	volume = LinkProgramCachedAsync(&volumeVShader, &volumePShader);
+}
+
+void DeferredShading::Resize(int w, int h) {
+	if (!framebuffer || (w == width && h == height) || !w || !h)
+		return;
+	width = w;
+	height = h;
+	MakeTargets();
+}
+
+void DeferredShading::Release() {
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteRenderbuffers(1, &depth);
+	glDeleteTextures(3, textures);
+	glDeleteBuffers(1, &volumeBuffer);
+	glDeleteBuffers(1, &volumeIndices);
+	glDeleteProgram(composite);
+	glDeleteProgram(volume);
+	framebuffer = depth = volumeBuffer = volumeIndices = composite = volume = 0;
+}
+
+// Geometry pass
+
+void DeferredShading::BeginGeometry(GLState &state) {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	GLenum all[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+	glDrawBuffers(3, all);
+	glClearColor(0, 0, 0, 0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	state.Disable(GL_BLEND);   // alpha of gNormal is a flag, not coverage
+	state.Enable(GL_DEPTH_TEST);
+}
+
+void DeferredShading::SetOutputs(GLuint program) {
+	// route each output to its attachment, whatever location the linker gave it
+	auto o = outputs.find(program);
+	if (o == outputs.end()) {
+		const char *names[] = { "gPosition", "gNormal", "pColor" };
+		std::vector<GLenum> buffers(3, GL_NONE);
+		for (int i = 0; i < 3; i++) {
+			GLint loc = glGetFragDataLocation(program, names[i]);
+			if (loc >= 0 && loc < 3)
+				buffers[loc] = GL_COLOR_ATTACHMENT0 + i;
+		}
+		o = outputs.insert({ program, buffers }).first;
+	}
+	glDrawBuffers(3, o->second.data());
+}
+
+void DeferredShading::EndGeometry() {
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Lighting pass
+
+void DeferredShading::BindGBuffer(GLState &state, GLuint program) {
+	const char *names[] = { "gPosition", "gNormal", "gAlbedo" };
+	for (int i = 0; i < 3; i++) {
+		state.BindTexture(textureUnit + i, GL_TEXTURE_2D, textures[i]);
+		state.SetUniform(program, names[i], textureUnit + i);
+	}
+}
+
+void DeferredShading::Light(GLState &state, const std::vector<PointLight> &lights, mat4 persp) {
+	state.Disable(GL_DEPTH_TEST);
+	state.Disable(GL_BLEND);
+	// unlit pixels
+	state.UseProgram(AwaitProgram(composite));
+	BindGBuffer(state, composite);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	// lights, added
+	state.UseProgram(AwaitProgram(volume));
+	BindGBuffer(state, volume);
+	state.SetUniform(volume, "persp", persp);
+	state.BindBuffer(GL_ARRAY_BUFFER, volumeBuffer);
+	state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, volumeIndices);
+	VertexAttribPointer(volume, "point", 3, 0, (void *) 0);
+	state.Enable(GL_BLEND);
+	state.BlendFunc(GL_ONE, GL_ONE);
+	state.Enable(GL_CULL_FACE);
+	glCullFace(GL_FRONT);
+	GLint lightLoc = glGetUniformLocation(volume, "light"), colorLoc = glGetUniformLocation(volume, "color");
+	for (const PointLight &l : lights) {
+		// per-light values change every draw, so bypass state's cache
+		vec4 lr(l.position, l.radius);
+		glUniform4fv(lightLoc, 1, &lr.x);
+		glUniform3fv(colorLoc, 1, &l.color.x);
+		glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, (void *) 0);
+	}
+	glCullFace(GL_BACK);
+	state.Disable(GL_CULL_FACE);
+	state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
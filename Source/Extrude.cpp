@@ -0,0 +1,179 @@
+// Extrude.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "Extrude.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static int extruded = 0, cacheHits = 0;
+static double extrudeMs = 0;
+
+// Triangulation
+
+static float Cross(vec2 a, vec2 b, vec2 c) {
+	// twice signed area of abc, positive if counter-clockwise
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool Inside(vec2 p, vec2 a, vec2 b, vec2 c) {
+	// inclusive of edges, abc counter-clockwise
+	return Cross(a, b, p) >= 0 && Cross(b, c, p) >= 0 && Cross(c, a, p) >= 0;
+}
+
+bool Triangulate(const std::vector<vec2> &outline, std::vector<int3> &triangles) {
+	int n = (int) outline.size();
+	if (n < 3)
+		return false;
+	float area = 0;
+	for (int i = 0; i < n; i++)
+		area += outline[i].x * outline[(i + 1) % n].y - outline[(i + 1) % n].x * outline[i].y;
+	// remaining polygon, counter-clockwise
+	std::vector<int> v(n);
+	for (int i = 0; i < n; i++)
+		v[i] = area > 0 ? i : n - 1 - i;
+	while (v.size() > 3) {
+		int m = (int) v.size(), ear = -1;
+		for (int i = 0; i < m && ear < 0; i++) {
+			int a = v[(i + m - 1) % m], b = v[i], c = v[(i + 1) % m];
+			float turn = Cross(outline[a], outline[b], outline[c]);
+			if (turn == 0) {
+				ear = i;                // collinear: drop b, no triangle
+				break;
+			}
+			if (turn < 0)
+				continue;               // reflex
+			bool empty = true;
+			for (int k = 0; k < m && empty; k++) {
+				int p = v[k];
+				if (p != a && p != b && p != c && Inside(outline[p], outline[a], outline[b], outline[c]))
+					empty = false;
+			}
+			if (empty) {
+				triangles.push_back(int3(a, b, c));
+				ear = i;
+			}
+		}
+		if (ear < 0)
+			return false;
+		v.erase(v.begin() + ear);
+	}
+	if (Cross(outline[v[0]], outline[v[1]], outline[v[2]]) != 0)
+		triangles.push_back(int3(v[0], v[1], v[2]));
+	return true;
+}
+
+// Extrusion
+
+namespace {
+
+struct Welder {
+	// vertices keyed by quantized position and normal
+	ExtrudedMesh &mesh;
+	std::map<std::array<long, 6>, int> index;
+	Welder(ExtrudedMesh &mesh) : mesh(mesh) { }
+	int Add(vec3 p, vec3 n) {
+		std::array<long, 6> key;
+		for (int k = 0; k < 3; k++) {
+			key[k] = lroundf(p[k] * 1e5f);
+			key[3 + k] = lroundf(n[k] * 1e4f);
+		}
+		auto i = index.find(key);
+		if (i != index.end())
+			return i->second;
+		mesh.points.push_back(p);
+		mesh.normals.push_back(n);
+		return index[key] = (int) mesh.points.size() - 1;
+	}
+};
+
+} // end namespace
+
+ExtrudedMesh Extrude(const std::vector<vec2> &outline, float depth) {
+	Clock::time_point start = Clock::now();
+	ExtrudedMesh mesh;
+	std::vector<int3> cap;
+	if (!Triangulate(outline, cap)) {
+		printf("Extrude: can't triangulate outline of %i points\n", (int) outline.size());
+		return mesh;
+	}
+	Welder welder(mesh);
+	float z0 = -depth / 2, z1 = depth / 2;
+	// caps: near reversed to face -z
+	for (int3 t : cap) {
+		int i[] = { t.i1, t.i2, t.i3 };
+		int n0 = welder.Add(vec3(outline[i[0]].x, outline[i[0]].y, z0), vec3(0, 0, -1));
+		int n1 = welder.Add(vec3(outline[i[1]].x, outline[i[1]].y, z0), vec3(0, 0, -1));
+		int n2 = welder.Add(vec3(outline[i[2]].x, outline[i[2]].y, z0), vec3(0, 0, -1));
+		mesh.triangles.push_back(int3(n0, n2, n1));
+		int f0 = welder.Add(vec3(outline[i[0]].x, outline[i[0]].y, z1), vec3(0, 0, 1));
+		int f1 = welder.Add(vec3(outline[i[1]].x, outline[i[1]].y, z1), vec3(0, 0, 1));
+		int f2 = welder.Add(vec3(outline[i[2]].x, outline[i[2]].y, z1), vec3(0, 0, 1));
+		mesh.triangles.push_back(int3(f0, f1, f2));
+	}
+	// walls: outward normal of each edge, counter-clockwise outline
+	int n = (int) outline.size();
+	float area = 0;
+	for (int i = 0; i < n; i++)
+		area += outline[i].x * outline[(i + 1) % n].y - outline[(i + 1) % n].x * outline[i].y;
+	for (int i = 0; i < n; i++) {
+		vec2 a = outline[i], b = outline[(i + 1) % n];
+		if (area < 0)
+			std::swap(a, b);
+		vec2 d = b - a;
+		float len = sqrtf(d.x * d.x + d.y * d.y);
+		if (len == 0)
+			continue;
+		vec3 normal(d.y / len, -d.x / len, 0);
+		int a0 = welder.Add(vec3(a.x, a.y, z0), normal), b0 = welder.Add(vec3(b.x, b.y, z0), normal);
+		int b1 = welder.Add(vec3(b.x, b.y, z1), normal), a1 = welder.Add(vec3(a.x, a.y, z1), normal);
+		mesh.triangles.push_back(int3(a0, b0, b1));
+		mesh.triangles.push_back(int3(a0, b1, a1));
+	}
+	mesh.bounds = BoundingBox(mesh.points);
+	extruded++;
+	extrudeMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	return mesh;
+}
+
+// Cache
+
+const ExtrudedMesh &ExtrudeCached(const std::vector<vec2> &outline, float depth) {
+	static std::map<std::string, ExtrudedMesh> cache;
+	std::string key((const char *) &depth, sizeof(depth));
+	key.append((const char *) outline.data(), outline.size() * sizeof(vec2));
+	auto c = cache.find(key);
+	if (c != cache.end()) {
+		cacheHits++;
+		return c->second;
+	}
+	return cache[key] = Extrude(outline, depth);
+}
+
+ExtrudedMesh ExtrudeOutlines(const std::vector<std::vector<vec2>> &outlines, const std::vector<vec2> &offsets, float depth) {
+	ExtrudedMesh mesh;
+	for (size_t o = 0; o < outlines.size(); o++) {
+		const ExtrudedMesh &m = ExtrudeCached(outlines[o], depth);
+		vec2 offset = o < offsets.size() ? offsets[o] : vec2(0, 0);
+		int first = (int) mesh.points.size();
+		for (size_t i = 0; i < m.points.size(); i++) {
+			mesh.points.push_back(m.points[i] + vec3(offset.x, offset.y, 0));
+			mesh.normals.push_back(m.normals[i]);
+		}
+		for (int3 t : m.triangles)
+			mesh.triangles.push_back(int3(first + t.i1, first + t.i2, first + t.i3));
+	}
+	mesh.bounds = BoundingBox(mesh.points);
+	return mesh;
+}
+
+void PrintExtrudeStats(const char *title) {
+	printf("%s%s%i outlines extruded (%.2f ms), %i from cache\n", title ? title : "", title ? ": " : "", extruded, extrudeMs, cacheHits);
+}
@@ -0,0 +1,151 @@
+// Frustum.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <math.h>
+#include <stdio.h>
+#include "Frustum.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE
+#endif
+
+// Bounding Volumes
+
+AABB BoundingBox(const vec3 *points, int npoints) {
+	if (npoints <= 0)
+		return AABB();
+	AABB b(points[0], points[0]);
+	for (int i = 1; i < npoints; i++) {
+		vec3 p = points[i];
+		for (int k = 0; k < 3; k++) {
+			if (p[k] < b.min[k]) b.min[k] = p[k];
+			if (p[k] > b.max[k]) b.max[k] = p[k];
+		}
+	}
+	return b;
+}
+
+AABB BoundingBox(const std::vector<vec3> &points) {
+	return BoundingBox(points.data(), (int) points.size());
+}
+
+Sphere BoundingSphere(const vec3 *points, int npoints) {
+	// centered on bounding box, radius to farthest point
+	vec3 c = BoundingBox(points, npoints).Center();
+	float r2 = 0;
+	for (int i = 0; i < npoints; i++) {
+		vec3 v = points[i] - c;
+		float d2 = dot(v, v);
+		if (d2 > r2) r2 = d2;
+	}
+	return Sphere(c, sqrt(r2));
+}
+
+Sphere BoundingSphere(const std::vector<vec3> &points) {
+	return BoundingSphere(points.data(), (int) points.size());
+}
+
+// Frustum
+
+void Frustum::Set(mat4 m) {
+	// Gribb-Hartmann: planes are sums/differences of last row with others
+	vec4 planes[6] = { m[3]+m[0], m[3]-m[0], m[3]+m[1], m[3]-m[1], m[3]+m[2], m[3]-m[2] };
+	for (int i = 0; i < 8; i++) {
+		vec4 p = planes[i < 6 ? i : 0];
+		float len = sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+		if (len > 0)
+			p = p / len;
+		nx[i] = p.x, ny[i] = p.y, nz[i] = p.z, d[i] = p.w;
+		ax[i] = fabs(p.x), ay[i] = fabs(p.y), az[i] = fabs(p.z);
+	}
+}
+
+bool Frustum::TestSphere(vec3 c, float r) const {
+	// outside if signed distance to any plane < -r
+#ifdef FRUSTUM_SSE
+	__m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z), nr = _mm_set1_ps(-r);
+	for (int i = 0; i < 8; i += 4) {
+		__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(nx+i), cx), _mm_mul_ps(_mm_load_ps(ny+i), cy)),
+								 _mm_add_ps(_mm_mul_ps(_mm_load_ps(nz+i), cz), _mm_load_ps(d+i)));
+		if (_mm_movemask_ps(_mm_cmplt_ps(dist, nr)))
+			return false;
+	}
+	return true;
+#else
+	for (int i = 0; i < 6; i++)
+		if (nx[i]*c.x + ny[i]*c.y + nz[i]*c.z + d[i] < -r)
+			return false;
+	return true;
+#endif
+}
+
+bool Frustum::TestBox(vec3 c, vec3 e) const {
+	// box projected radius onto plane normal is |n|.e
+#ifdef FRUSTUM_SSE
+	__m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+	__m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+	for (int i = 0; i < 8; i += 4) {
+		__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(nx+i), cx), _mm_mul_ps(_mm_load_ps(ny+i), cy)),
+								 _mm_add_ps(_mm_mul_ps(_mm_load_ps(nz+i), cz), _mm_load_ps(d+i)));
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(ax+i), ex), _mm_mul_ps(_mm_load_ps(ay+i), ey)),
+							  _mm_mul_ps(_mm_load_ps(az+i), ez));
+		if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, r), _mm_setzero_ps())))
+			return false;
+	}
+	return true;
+#else
+	for (int i = 0; i < 6; i++)
+		if (nx[i]*c.x + ny[i]*c.y + nz[i]*c.z + d[i] + ax[i]*e.x + ay[i]*e.y + az[i]*e.z < 0)
+			return false;
+	return true;
+#endif
+}
+
+bool Frustum::Count(bool visible) {
+	if (visible)
+		submitted++;
+	else
+		culled++;
+	return visible;
+}
+
+bool Frustum::Visible(const Sphere &s) {
+	return Count(!enabled || TestSphere(s.center, s.radius));
+}
+
+bool Frustum::Visible(const AABB &b) {
+	return Count(!enabled || TestBox(b.Center(), b.Extent()));
+}
+
+bool Frustum::Visible(mat4 m, const Sphere &local) {
+	if (!enabled)
+		return Count(true);
+	// transform center, scale radius by largest column of upper 3x3
+	vec4 c = m * vec4(local.center, 1);
+	float s2 = 0;
+	for (int j = 0; j < 3; j++) {
+		float c2 = m[0][j]*m[0][j] + m[1][j]*m[1][j] + m[2][j]*m[2][j];
+		if (c2 > s2) s2 = c2;
+	}
+	return Count(TestSphere(vec3(c.x, c.y, c.z), local.radius * sqrt(s2)));
+}
+
+bool Frustum::Visible(mat4 m, const AABB &local) {
+	if (!enabled)
+		return Count(true);
+	// transformed box bound (Arvo): extent_i = sum_j |m_ij| e_j
+	vec3 lc = local.Center(), le = local.Extent();
+	vec4 c = m * vec4(lc, 1);
+	vec3 e;
+	for (int i = 0; i < 3; i++)
+		e[i] = fabs(m[i][0])*le.x + fabs(m[i][1])*le.y + fabs(m[i][2])*le.z;
+	return Count(TestBox(vec3(c.x, c.y, c.z), e));
+}
+
+void Frustum::PrintStats(const char *title) const {
+	int total = submitted + culled;
+	printf("%s%s%i draws submitted, %i culled (%.1f%%)\n", title ? title : "", title ? ": " : "",
+		   submitted, culled, total ? 100.f * culled / total : 0.f);
+}
@@ -0,0 +1,97 @@
+// GLCount.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <glad.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "GLCount.h"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// entrypoints counted (those the apps and shared code call per frame)
+#define GL_COUNTED(X) \
+	X(glActiveTexture) X(glBeginQuery) X(glBindBuffer) X(glBindFramebuffer) X(glBindTexture) \
+	X(glBlendFunc) X(glBufferData) X(glBufferSubData) X(glClear) X(glClearColor) \
+	X(glClientWaitSync) X(glColorMask) X(glDeleteSync) X(glDepthFunc) X(glDepthMask) X(glDisable) \
+	X(glDrawArrays) X(glDrawArraysInstanced) X(glDrawElements) X(glDrawElementsInstanced) \
+	X(glEnable) X(glEnableVertexAttribArray) X(glEndQuery) X(glFenceSync) X(glFlush) \
+	X(glGetAttribLocation) X(glGetError) X(glGetIntegerv) X(glGetQueryObjectui64v) X(glGetQueryObjectuiv) X(glGetUniformLocation) \
+	X(glLineWidth) X(glPatchParameterfv) X(glPatchParameteri) X(glStencilFunc) X(glStencilMask) X(glStencilOp) \
+	X(glTexSubImage2D) X(glUniform1f) X(glUniform1i) X(glUniform1iv) X(glUniform2fv) X(glUniform3fv) \
+	X(glUniform4fv) X(glUniformMatrix4fv) X(glUseProgram) X(glVertexAttribDivisor) \
+	X(glVertexAttribPointer) X(glViewport) X(glViewportIndexedf)
+
+#define GL_COUNT_ID(name) ID_##name,
+enum { GL_COUNTED(GL_COUNT_ID) NUM_COUNTED };
+
+struct Entry {
+	const char *name = NULL;
+	long frame = 0, last = 0, total = 0;
+};
+
+static Entry entries[NUM_COUNTED];
+static int nFrames = 0;
+
+// Hook<ID> forwards to the original entrypoint, counting each call
+
+template <int ID, typename R, typename... A>
+struct Hook {
+	static R (APIENTRY *original)(A...);
+	static R APIENTRY Call(A... a) {
+		entries[ID].frame++;
+		return original(a...);
+	}
+};
+
+template <int ID, typename R, typename... A>
+R (APIENTRY *Hook<ID, R, A...>::original)(A...) = NULL;
+
+template <int ID, typename R, typename... A>
+void Install(R (APIENTRY *&fn)(A...), const char *name) {
+	entries[ID].name = name;
+	if (!fn || Hook<ID, R, A...>::original)
+		return;                        // not loaded, or already wrapped
+	Hook<ID, R, A...>::original = fn;
+	fn = Hook<ID, R, A...>::Call;
+}
+
+void GLCountInstall() {
+#define GL_COUNT_INSTALL(name) Install<ID_##name>(glad_##name, #name);
+	GL_COUNTED(GL_COUNT_INSTALL)
+}
+
+void GLCountNewFrame() {
+	for (Entry &e : entries) {
+		e.last = e.frame;
+		e.total += e.frame;
+		e.frame = 0;
+	}
+	nFrames++;
+}
+
+int GLCountFrameCalls() {
+	long sum = 0;
+	for (Entry &e : entries)
+		sum += e.last;
+	return (int) sum;
+}
+
+void GLCountPrint(const char *title) {
+	long total = 0;
+	std::vector<Entry *> used;
+	for (Entry &e : entries)
+		if (e.total) {
+			used.push_back(&e);
+			total += e.total;
+		}
+	std::sort(used.begin(), used.end(), [](Entry *a, Entry *b) { return a->total > b->total; });
+	float n = nFrames ? (float) nFrames : 1.f;
+	printf("%s%sGL calls: %i last frame, %.1f/frame over %i frames\n", title ? title : "", title ? ": " : "",
+		   GLCountFrameCalls(), total / n, nFrames);
+	for (Entry *e : used)
+		printf("  %-26s %6li last frame %9.1f/frame\n", e->name, e->last, e->total / n);
+}
@@ -0,0 +1,172 @@
+// GLState.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include <string.h>
+#include "GLState.h"
+
+// Bookkeeping
+
+bool GLState::Changed(bool same) {
+	if (same)
+		elided++;
+	else
+		issued++;
+	return !same;
+}
+
+void GLState::NewFrame() {
+	lastIssued = issued;
+	lastElided = elided;
+	issued = elided = 0;
+}
+
+void GLState::PrintStats(const char *title) const {
+	printf("%s%s%i state calls issued, %i elided\n", title ? title : "", title ? ": " : "", lastIssued, lastElided);
+}
+
+void GLState::Invalidate() {
+	caps.clear();
+	buffers.clear();
+	textures.clear();
+	programKnown = false;
+	activeUnit = -1;
+	blendSrc = blendDst = 0;
+}
+
+void GLState::InvalidateBuffer(GLenum target) {
+	buffers.erase(target);
+}
+
+void GLState::InvalidateTextures() {
+	textures.clear();
+	activeUnit = -1;
+}
+
+void GLState::Forget(GLuint p) {
+	programs.erase(p);
+}
+
+// State
+
+void GLState::Enable(GLenum cap) {
+	auto c = caps.find(cap);
+	if (Changed(c != caps.end() && c->second)) {
+		glEnable(cap);
+		caps[cap] = true;
+	}
+}
+
+void GLState::Disable(GLenum cap) {
+	auto c = caps.find(cap);
+	if (Changed(c != caps.end() && !c->second)) {
+		glDisable(cap);
+		caps[cap] = false;
+	}
+}
+
+void GLState::BlendFunc(GLenum src, GLenum dst) {
+	if (Changed(src == blendSrc && dst == blendDst)) {
+		glBlendFunc(src, dst);
+		blendSrc = src;
+		blendDst = dst;
+	}
+}
+
+void GLState::UseProgram(GLuint p) {
+	if (Changed(programKnown && p == program)) {
+		glUseProgram(p);
+		program = p;
+		programKnown = true;
+	}
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer) {
+	auto b = buffers.find(target);
+	if (Changed(b != buffers.end() && b->second == buffer)) {
+		glBindBuffer(target, buffer);
+		buffers[target] = buffer;
+	}
+}
+
+void GLState::BindTexture(int unit, GLenum target, GLuint texture) {
+	auto t = textures.find(unit);
+	if (!Changed(t != textures.end() && t->second == texture))
+		return;
+	if (Changed(unit == activeUnit)) {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		activeUnit = unit;
+	}
+	glBindTexture(target, texture);
+	textures[unit] = texture;
+}
+
+// Uniforms
+
+GLint GLState::Location(GLuint p, const char *name) {
+	ProgramCache &pc = programs[p];
+	auto l = pc.locations.find(name);
+	if (l != pc.locations.end())
+		return l->second;
+	GLint loc = glGetUniformLocation(p, name);
+	pc.locations[name] = loc;
+	return loc;
+}
+
+bool GLState::NewValue(GLuint p, GLint loc, const void *data, int nBytes) {
+	std::vector<char> &v = programs[p].values[loc];
+	bool same = (int) v.size() == nBytes && !memcmp(v.data(), data, nBytes);
+	if (!same)
+		v.assign((const char *) data, (const char *) data + nBytes);
+	return Changed(same);
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, bool b) {
+	return SetUniform(p, name, b ? 1 : 0);
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, int i) {
+	GLint loc = Location(p, name);
+	if (loc < 0)
+		return false;
+	if (NewValue(p, loc, &i, sizeof(int)))
+		glUniform1i(loc, i);
+	return true;
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, float f) {
+	GLint loc = Location(p, name);
+	if (loc < 0)
+		return false;
+	if (NewValue(p, loc, &f, sizeof(float)))
+		glUniform1f(loc, f);
+	return true;
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, vec3 v) {
+	GLint loc = Location(p, name);
+	if (loc < 0)
+		return false;
+	if (NewValue(p, loc, &v.x, sizeof(vec3)))
+		glUniform3fv(loc, 1, &v.x);
+	return true;
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, vec3 *v, int count) {
+	GLint loc = Location(p, name);
+	if (loc < 0)
+		return false;
+	if (NewValue(p, loc, &v[0].x, count * sizeof(vec3)))
+		glUniform3fv(loc, count, &v[0].x);
+	return true;
+}
+
+bool GLState::SetUniform(GLuint p, const char *name, mat4 m) {
+	GLint loc = Location(p, name);
+	if (loc < 0)
+		return false;
+	if (NewValue(p, loc, &m[0][0], sizeof(mat4)))
+		glUniformMatrix4fv(loc, 1, GL_TRUE, &m[0][0]);  // mat4 is row-major
+	return true;
+}
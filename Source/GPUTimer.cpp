@@ -0,0 +1,57 @@
+// GPUTimer.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include "GPUTimer.h"
+
+void GPUTimer::Collect() {
+	for (int i = 0; i < 3; i++) {
+		if (!issued[i])
+			continue;
+		GLuint available = 0;
+		glGetQueryObjectuiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			continue;
+		GLuint64 ns = 0;
+		glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &ns);
+		ms = (float) (ns / 1e6);
+		sum += ms;
+		count++;
+		issued[i] = false;
+	}
+}
+
+void GPUTimer::Begin() {
+	if (!queries[0])
+		glGenQueries(3, queries);
+	Collect();
+	active = !issued[next];
+	if (active)
+		glBeginQuery(GL_TIME_ELAPSED, queries[next]);
+}
+
+void GPUTimer::End() {
+	if (!active)
+		return;
+	glEndQuery(GL_TIME_ELAPSED);
+	issued[next] = true;
+	next = (next + 1) % 3;
+	active = false;
+}
+
+void GPUTimer::Reset() {
+	// results still in flight were timed under the old settings: drop them
+	for (bool &i : issued)
+		i = false;
+	sum = 0;
+	count = 0;
+}
+
+void GPUTimer::Release() {
+	if (queries[0])
+		glDeleteQueries(3, queries);
+	for (int i = 0; i < 3; i++) {
+		queries[i] = 0;
+		issued[i] = false;
+	}
+}
@@ -0,0 +1,160 @@
+// LightClusters.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include "LightClusters.h"
+
+// Textures
+
+static GLuint MakeTexture(GLenum target) {
+	GLuint t = 0;
+	glGenTextures(1, &t);
+	glBindTexture(target, t);
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	return t;
+}
+
+void LightClusters::Init() {
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	grid = MakeTexture(GL_TEXTURE_3D);
+	glTexImage3D(GL_TEXTURE_3D, 0, GL_RG32UI, nx, ny, nz, 0, GL_RG_INTEGER, GL_UNSIGNED_INT, NULL);
+	glActiveTexture(GL_TEXTURE0 + textureUnit + 1);
+	indices = MakeTexture(GL_TEXTURE_2D);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, INDEX_ROW, maxIndices / INDEX_ROW, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+	glActiveTexture(GL_TEXTURE0 + textureUnit + 2);
+	lightData = MakeTexture(GL_TEXTURE_2D);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 2 * maxLights, 1, 0, GL_RGBA, GL_FLOAT, NULL);
+	glActiveTexture(GL_TEXTURE0);
+	cells.resize(2 * nx * ny * nz);
+}
+
+void LightClusters::Release() {
+	GLuint textures[] = { grid, indices, lightData };
+	glDeleteTextures(3, textures);
+	grid = indices = lightData = 0;
+}
+
+// Binning
+
+int LightClusters::Slice(float depth) const {
+	// inverse of the shader's log(depth)*clusterScale.z+clusterBias
+	if (depth <= nearZ)
+		return 0;
+	int s = (int) (log(depth / nearZ) / log(farZ / nearZ) * nz);
+	return s < 0 ? 0 : s >= nz ? nz - 1 : s;
+}
+
+void LightClusters::Build(const std::vector<PointLight> &lights, mat4 persp, int w, int h) {
+	width = w;
+	height = h;
+	nLights = (int) lights.size() < maxLights ? (int) lights.size() : maxLights;
+	// cluster range [lo, hi] of each light, or empty if out of view
+	struct Range { int lo[3], hi[3]; };
+	std::vector<Range> ranges(nLights);
+	for (int i = 0; i < nLights; i++) {
+		const PointLight &l = lights[i];
+		Range &r = ranges[i];
+		float zNear = -l.position.z - l.radius, zFar = -l.position.z + l.radius;
+		r.lo[2] = Slice(zNear);
+		r.hi[2] = zFar > 0 ? Slice(zFar) : -1;
+		r.lo[0] = r.lo[1] = 0;
+		r.hi[0] = nx - 1;
+		r.hi[1] = ny - 1;
+		if (zNear > nearZ) {
+			// all of light's box in front of eye: bound its projection
+			float x0 = 1, y0 = 1, x1 = -1, y1 = -1;
+			for (int k = 0; k < 8; k++) {
+				vec3 c = l.position + l.radius * vec3(k & 1 ? 1.f : -1.f, k & 2 ? 1.f : -1.f, k & 4 ? 1.f : -1.f);
+				vec4 p = persp * vec4(c, 1);
+				float x = p.x / p.w, y = p.y / p.w;
+				x0 = x < x0 ? x : x0; x1 = x > x1 ? x : x1;
+				y0 = y < y0 ? y : y0; y1 = y > y1 ? y : y1;
+			}
+			r.lo[0] = (int) floor((x0 * .5f + .5f) * nx); r.hi[0] = (int) floor((x1 * .5f + .5f) * nx);
+			r.lo[1] = (int) floor((y0 * .5f + .5f) * ny); r.hi[1] = (int) floor((y1 * .5f + .5f) * ny);
+			int n[] = { nx, ny };
+			for (int a = 0; a < 2; a++) {
+				r.lo[a] = r.lo[a] < 0 ? 0 : r.lo[a];
+				r.hi[a] = r.hi[a] >= n[a] ? n[a] - 1 : r.hi[a];
+			}
+		}
+	}
+	// count per cluster, then offsets, then fill
+	std::fill(cells.begin(), cells.end(), 0);
+	auto Cell = [this](int x, int y, int z) { return 2 * (x + nx * (y + ny * z)); };
+	for (Range &r : ranges)
+		for (int z = r.lo[2]; z <= r.hi[2]; z++)
+			for (int y = r.lo[1]; y <= r.hi[1]; y++)
+				for (int x = r.lo[0]; x <= r.hi[0]; x++)
+					cells[Cell(x, y, z) + 1]++;
+	unsigned int total = 0;
+	for (size_t c = 0; c < cells.size(); c += 2) {
+		cells[c] = total;
+		total += cells[c + 1];
+		cells[c + 1] = 0;
+	}
+	assigned = (int) total;
+	dropped = 0;
+	list.resize(total);
+	for (int i = 0; i < nLights; i++) {
+		Range &r = ranges[i];
+		for (int z = r.lo[2]; z <= r.hi[2]; z++)
+			for (int y = r.lo[1]; y <= r.hi[1]; y++)
+				for (int x = r.lo[0]; x <= r.hi[0]; x++) {
+					unsigned int *cell = &cells[Cell(x, y, z)];
+					list[cell[0] + cell[1]++] = i;
+				}
+	}
+	// clip to index texture capacity
+	for (size_t c = 0; c < cells.size(); c += 2)
+		if (cells[c] + cells[c + 1] > (unsigned int) maxIndices) {
+			unsigned int keep = cells[c] < (unsigned int) maxIndices ? maxIndices - cells[c] : 0;
+			dropped += cells[c + 1] - keep;
+			cells[c + 1] = keep;
+		}
+	// upload
+	texels.resize(2 * nLights);
+	for (int i = 0; i < nLights; i++) {
+		texels[2 * i] = vec4(lights[i].position, lights[i].radius);
+		texels[2 * i + 1] = vec4(lights[i].color, 1);
+	}
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_3D, grid);
+	glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, nx, ny, nz, GL_RG_INTEGER, GL_UNSIGNED_INT, cells.data());
+	int nIndices = total < (unsigned int) maxIndices ? (int) total : maxIndices;
+	int nRows = (nIndices + INDEX_ROW - 1) / INDEX_ROW;
+	if (nRows) {
+		list.resize(nRows * INDEX_ROW);
+		glActiveTexture(GL_TEXTURE0 + textureUnit + 1);
+		glBindTexture(GL_TEXTURE_2D, indices);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, INDEX_ROW, nRows, GL_RED_INTEGER, GL_UNSIGNED_INT, list.data());
+	}
+	if (nLights) {
+		glActiveTexture(GL_TEXTURE0 + textureUnit + 2);
+		glBindTexture(GL_TEXTURE_2D, lightData);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 2 * nLights, 1, GL_RGBA, GL_FLOAT, texels.data());
+	}
+}
+
+// Shading
+
+void LightClusters::Use(GLState &state, GLuint program) {
+	state.BindTexture(textureUnit, GL_TEXTURE_3D, grid);
+	state.BindTexture(textureUnit + 1, GL_TEXTURE_2D, indices);
+	state.BindTexture(textureUnit + 2, GL_TEXTURE_2D, lightData);
+	state.SetUniform(program, "clusterGrid", textureUnit);
+	state.SetUniform(program, "clusterIndices", textureUnit + 1);
+	state.SetUniform(program, "clusterLights", textureUnit + 2);
+	float zScale = nz / log(farZ / nearZ);
+	state.SetUniform(program, "clusterScale", vec3((float) nx / width, (float) ny / height, zScale));
+	state.SetUniform(program, "clusterBias", -log(nearZ) * zScale);
+}
+
+void LightClusters::PrintStats(const char *title) const {
+	printf("%s%s%i lights in %i clusters, %i assignments (%.1f per cluster), %i dropped\n", title ? title : "", title ? ": " : "",
+		   nLights, nx * ny * nz, assigned, (float) assigned / (nx * ny * nz), dropped);
+}
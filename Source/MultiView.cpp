@@ -0,0 +1,106 @@
+// MultiView.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include <string.h>
+#include "GLXtras.h"
+#include "MultiView.h"
+
+// Views
+
+void MultiView::SetViews(const std::vector<View> &v) {
+	size_t n = v.size() < MULTIVIEW_MAX ? v.size() : MULTIVIEW_MAX;
+	bool resized = n != views.size();
+	if (resized)
+		frusta.resize(n);
+	for (size_t i = 0; i < n; i++)
+		if (resized || memcmp(&views[i].viewProj, &v[i].viewProj, sizeof(mat4)))
+			frusta[i].Set(v[i].viewProj);
+	views.assign(v.begin(), v.begin() + n);
+}
+
+bool MultiView::Supported() const {
+	return glViewportIndexedf != NULL;
+}
+
+void MultiView::Viewport(int i) const {
+	glViewport(views[i].x, views[i].y, views[i].width, views[i].height);
+}
+
+// Culling: bounds to world once, then each view's planes
+
+unsigned MultiView::Cull(mat4 model, const AABB &local) {
+	vec3 corners[8];
+	for (int k = 0; k < 8; k++) {
+		vec4 c(k & 1 ? local.max.x : local.min.x, k & 2 ? local.max.y : local.min.y, k & 4 ? local.max.z : local.min.z, 1);
+		vec4 w = model * c;
+		corners[k] = vec3(w.x, w.y, w.z);
+	}
+	AABB world = BoundingBox(corners, 8);
+	unsigned mask = 0;
+	for (size_t i = 0; i < views.size(); i++)
+		if (frusta[i].Visible(world))
+			mask |= 1u << i;
+	return mask;
+}
+
+// Drawing
+
+void MultiView::Draw(GLuint layeredProgram, GLuint program, mat4 model, unsigned mask, const std::function<void(int)> &draw) {
+	int n = 0, index[MULTIVIEW_MAX];
+	for (size_t i = 0; i < views.size(); i++)
+		if (mask & 1u << i)
+			index[n++] = (int) i;
+	if (!n)
+		return;
+	if (layered && layeredProgram && Supported()) {
+		// visible views compacted: instance i draws views[index[i]]
+		mat4 m[MULTIVIEW_MAX];
+		for (int i = 0; i < n; i++) {
+			const View &v = views[index[i]];
+			m[i] = v.viewProj * model;
+			glViewportIndexedf(index[i], (float) v.x, (float) v.y, (float) v.width, (float) v.height);
+		}
+		glUseProgram(layeredProgram);
+		glUniformMatrix4fv(glGetUniformLocation(layeredProgram, "views"), n, GL_TRUE, (float *) m);
+		glUniform1iv(glGetUniformLocation(layeredProgram, "viewIndex"), n, index);
+		draw(n);
+		layeredDraws++;
+		return;
+	}
+	glUseProgram(program);
+	for (int i = 0; i < n; i++) {
+		int v = index[i];
+		mat4 m = views[v].viewProj * model;
+		Viewport(v);
+		// a program keeps its uniform: upload only if this program last had another matrix
+		size_t u = 0;
+		while (u < uploaded.size() && uploaded[u].first != program)
+			u++;
+		if (u == uploaded.size())
+			uploaded.push_back({ program, mat4(0) });
+		if (memcmp(&uploaded[u].second, &m, sizeof(mat4))) {
+			SetUniform(program, "view", m);
+			uploaded[u].second = m;
+		}
+		draw(1);
+		viewDraws++;
+	}
+}
+
+void MultiView::ResetStats() {
+	layeredDraws = viewDraws = 0;
+	for (Frustum &f : frusta)
+		f.ResetStats();
+}
+
+void MultiView::PrintStats(const char *title) const {
+	printf("%s%s%i views, %s: %i layered draws, %i per-view draws\n", title ? title : "", title ? ": " : "",
+		   (int) views.size(), Supported() ? "viewport arrays" : "no viewport arrays", layeredDraws, viewDraws);
+	for (size_t i = 0; i < frusta.size(); i++) {
+		char name[32];
+		snprintf(name, sizeof(name), "%sview %i", title ? "  " : "", (int) i);
+		frusta[i].PrintStats(name);
+	}
+}
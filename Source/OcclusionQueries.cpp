@@ -0,0 +1,54 @@
+// OcclusionQueries.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include "OcclusionQueries.h"
+
+void OcclusionQueries::NewFrame() {
+	lastSkipped = skipped;
+	lastPending = pending;
+	skipped = pending = 0;
+	frame++;
+}
+
+bool OcclusionQueries::Visible(int id) {
+	auto q = queries.find(id);
+	if (!enabled || q == queries.end() || q->second.frame != frame - 1)
+		return true;
+	GLuint available = GL_FALSE, samples = 1;
+	glGetQueryObjectuiv(q->second.name, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) {
+		pending++;
+		return true;
+	}
+	glGetQueryObjectuiv(q->second.name, GL_QUERY_RESULT, &samples);
+	if (samples)
+		return true;
+	skipped++;
+	totalSkipped++;
+	return false;
+}
+
+void OcclusionQueries::Begin(int id) {
+	Query &q = queries[id];
+	if (!q.name)
+		glGenQueries(1, &q.name);
+	q.frame = frame;
+	glBeginQuery(GL_ANY_SAMPLES_PASSED, q.name);
+}
+
+void OcclusionQueries::End() {
+	glEndQuery(GL_ANY_SAMPLES_PASSED);
+}
+
+void OcclusionQueries::Release() {
+	for (auto &q : queries)
+		glDeleteQueries(1, &q.second.name);
+	queries.clear();
+}
+
+void OcclusionQueries::PrintStats(const char *title) const {
+	printf("%s%s%i passes skipped as hidden, %i results not ready (%li skipped in all)\n",
+		   title ? title : "", title ? ": " : "", lastSkipped, lastPending, totalSkipped);
+}
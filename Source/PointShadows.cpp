@@ -0,0 +1,130 @@
+// PointShadows.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include "PointShadows.h"
+#include "ProgramCache.h"
+
+// Depth-only shader: distance to light, normalized
+
+static const char *vShadowShader = R"(
+	#version 130
+	in vec3 point;
+	out vec3 wPoint;
+	uniform mat4 model, viewProj;
+	void main() {
+		wPoint = (model*vec4(point, 1)).xyz;
+		gl_Position = viewProj*vec4(wPoint, 1);
+	}
+)";
+
+static const char *pShadowShader = R"(
+	#version 130
+	in vec3 wPoint;
+	uniform vec3 light;
+	uniform float farZ;
+	void main() {
+		gl_FragDepth = length(wPoint-light)/farZ;
+	}
+)";
+
+// Setup
+
+void PointShadows::Init() {
+	maps.resize(2 * nLights);
+	lights.assign(nLights, vec3(0));
+	staticValid.assign(nLights, false);
+	glGenTextures(2 * nLights, maps.data());
+	for (GLuint m : maps) {
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m);
+		for (int f = 0; f < 6; f++)
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	}
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	glGenFramebuffers(1, &framebuffer);
+	program = LinkProgramCachedAsync(&vShadowShader, &pShadowShader);
+}
+
+void PointShadows::Release() {
+	if (!maps.empty())
+		glDeleteTextures((GLsizei) maps.size(), maps.data());
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteProgram(program);
+	maps.clear();
+	framebuffer = program = 0;
+}
+
+void PointShadows::SetLight(int i, vec3 world) {
+	vec3 d = world - lights[i];
+	if (dot(d, d) > 0)
+		staticValid[i] = false;
+	lights[i] = world;
+}
+
+void PointShadows::InvalidateStatic() {
+	staticValid.assign(nLights, false);
+}
+
+// Rendering
+
+void PointShadows::Render(GLState &state, std::function<int(Frustum &face, bool dynamic)> draw) {
+	// GL cube map face directions and up vectors
+	static const vec3 dirs[] = { {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+	static const vec3 ups[] = { {0,-1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}, {0,-1,0}, {0,-1,0} };
+	faces = cachedFaces = draws = 0;
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	glViewport(0, 0, size, size);
+	state.Enable(GL_DEPTH_TEST);
+	state.Disable(GL_BLEND);
+	state.UseProgram(AwaitProgram(program));
+	state.SetUniform(program, "farZ", farZ);
+	mat4 persp = Perspective(90, 1, nearZ, farZ);
+	for (int i = 0; i < nLights; i++) {
+		state.SetUniform(program, "light", lights[i]);
+		for (int layer = 0; layer < 2; layer++) {
+			bool dynamic = layer == 1;
+			if (!dynamic && staticValid[i]) {
+				cachedFaces += 6;
+				continue;
+			}
+			for (int f = 0; f < 6; f++) {
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, maps[2 * i + layer], 0);
+				glClear(GL_DEPTH_BUFFER_BIT);
+				mat4 viewProj = persp * LookAt(lights[i], lights[i] + dirs[f], ups[f]);
+				state.SetUniform(program, "viewProj", viewProj);
+				frustum.Set(viewProj);
+				draws += draw(frustum, dynamic);
+				faces++;
+			}
+			if (!dynamic)
+				staticValid[i] = true;
+		}
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void PointShadows::Use(GLState &state, GLuint p) {
+	const char *names[] = { "shadowStatic0", "shadowDynamic0", "shadowStatic1", "shadowDynamic1" };
+	for (int m = 0; m < (int) maps.size(); m++) {
+		state.BindTexture(textureUnit + m, GL_TEXTURE_CUBE_MAP, maps[m]);
+		if (m < 4)
+			state.SetUniform(p, names[m], textureUnit + m);
+	}
+	state.SetUniform(p, "shadowFar", farZ);
+	state.SetUniform(p, "shadowBias", bias);
+}
+
+void PointShadows::PrintStats(const char *title) const {
+	printf("%s%s%i shadow faces rendered (%i casters), %i cached\n", title ? title : "", title ? ": " : "", faces, draws, cachedFaces);
+}
@@ -0,0 +1,275 @@
+// ProgramCache.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ProgramCache.h"
+#ifdef _WIN32
+#include <direct.h>
+#define MakeDirectory(d) _mkdir(d)
+#else
+#include <sys/stat.h>
+#define MakeDirectory(d) mkdir(d, 0755)
+#endif
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static std::string cacheDir = "ProgramCache";
+static ProgramCacheStats stats;
+static bool parallel = false;
+static const unsigned int MAGIC = 0x42505447; // 'GTPB'
+static const GLenum stageTypes[] = {
+	GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER
+};
+
+// a program whose compile/link has been issued but whose status is not yet known
+struct Pending {
+	std::string sources[5];     // copies, to recompile if the driver rejects a cached binary
+	bool stages[5] = { false };
+	GLuint shaders[5] = { 0 };
+	std::string filename, driver;
+	bool fromBinary = false, retrievable = false;
+	double ms = 0;              // main-thread time spent so far
+};
+
+static std::unordered_map<GLuint, Pending> pending;
+
+void SetProgramCacheDirectory(const char *dir) {
+	cacheDir = dir;
+}
+
+ProgramCacheStats GetProgramCacheStats() {
+	return stats;
+}
+
+void PrintProgramCacheStats(const char *title) {
+	printf("%s%sprograms: %i from cache (%.1f ms), %i compiled (%.1f ms), %.1f ms blocked at first use\n",
+		   title ? title : "", title ? ": " : "", stats.hits, stats.hitMs, stats.misses, stats.missMs, stats.waitMs);
+}
+
+bool EnableParallelShaderCompile(GLADloadproc load) {
+	typedef void (APIENTRY *MaxThreadsProc)(GLuint);
+	const char *names[][2] = {
+		{ "GL_KHR_parallel_shader_compile", "glMaxShaderCompilerThreadsKHR" },
+		{ "GL_ARB_parallel_shader_compile", "glMaxShaderCompilerThreadsARB" }
+	};
+	GLint nExtensions = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &nExtensions);
+	for (auto &n : names)
+		for (int i = 0; i < nExtensions; i++) {
+			const char *e = (const char *) glGetStringi(GL_EXTENSIONS, i);
+			MaxThreadsProc maxThreads = e && !strcmp(e, n[0]) ? (MaxThreadsProc) load(n[1]) : NULL;
+			if (maxThreads) {
+				maxThreads(0xFFFFFFFF); // let driver choose thread count
+				return parallel = true;
+			}
+		}
+	return false;
+}
+
+// Key
+
+static void Hash(unsigned long long &h, const char *s) {
+	// FNV-1a, 64 bit; stage separator so (a, bc) differs from (ab, c)
+	for (; s && *s; s++)
+		h = (h ^ (unsigned char) *s) * 1099511628211ull;
+	h = (h ^ 0xff) * 1099511628211ull;
+}
+
+static std::string DriverString() {
+	std::string s;
+	GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	for (GLenum n : names) {
+		const char *v = (const char *) glGetString(n);
+		s += v ? v : "";
+		s += '\n';
+	}
+	return s;
+}
+
+// Cache file: magic, driver string, binary format, binary
+
+static bool ReadBinary(const char *filename, const std::string &driver, GLenum &format, std::vector<char> &binary) {
+	FILE *in = fopen(filename, "rb");
+	if (!in)
+		return false;
+	unsigned int magic = 0, nDriver = 0, nBinary = 0;
+	bool ok = fread(&magic, 4, 1, in) == 1 && magic == MAGIC && fread(&nDriver, 4, 1, in) == 1 && nDriver == driver.size();
+	if (ok) {
+		std::string d(nDriver, 0);
+		ok = fread(&d[0], 1, nDriver, in) == nDriver && d == driver &&
+			 fread(&format, sizeof(GLenum), 1, in) == 1 && fread(&nBinary, 4, 1, in) == 1 && nBinary > 0;
+	}
+	if (ok) {
+		binary.resize(nBinary);
+		ok = fread(binary.data(), 1, nBinary, in) == nBinary;
+	}
+	fclose(in);
+	return ok;
+}
+
+static void WriteBinary(const char *filename, const std::string &driver, GLuint program) {
+	GLint nBinary = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &nBinary);
+	if (nBinary <= 0)
+		return;
+	std::vector<char> binary(nBinary);
+	GLenum format = 0;
+	glGetProgramBinary(program, nBinary, NULL, &format, binary.data());
+	MakeDirectory(cacheDir.c_str());
+	FILE *out = fopen(filename, "wb");
+	if (!out)
+		return;
+	unsigned int nDriver = (unsigned int) driver.size(), n = (unsigned int) nBinary;
+	fwrite(&MAGIC, 4, 1, out);
+	fwrite(&nDriver, 4, 1, out);
+	fwrite(driver.data(), 1, nDriver, out);
+	fwrite(&format, sizeof(GLenum), 1, out);
+	fwrite(&n, 4, 1, out);
+	fwrite(binary.data(), 1, n, out);
+	fclose(out);
+}
+
+// Compile and link, without querying status (a status query would wait for the driver)
+
+static void IssueCompile(Pending &p, GLuint program) {
+	for (int i = 0; i < 5; i++)
+		if (p.stages[i]) {
+			const char *code = p.sources[i].c_str();
+			p.shaders[i] = glCreateShader(stageTypes[i]);
+			glShaderSource(p.shaders[i], 1, &code, NULL);
+			glCompileShader(p.shaders[i]);
+			glAttachShader(program, p.shaders[i]);
+		}
+	if (p.retrievable)
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+}
+
+static void PrintErrors(Pending &p, GLuint program) {
+	char log[1024];
+	for (int i = 0; i < 5; i++) {
+		GLint status = GL_TRUE;
+		if (p.shaders[i])
+			glGetShaderiv(p.shaders[i], GL_COMPILE_STATUS, &status);
+		if (status != GL_TRUE) {
+			glGetShaderInfoLog(p.shaders[i], sizeof(log), NULL, log);
+			printf("compile failed: %s\n", log);
+		}
+	}
+	glGetProgramInfoLog(program, sizeof(log), NULL, log);
+	printf("link failed: %s\n", log);
+}
+
+static bool Linked(GLuint program) {
+	GLint status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	return status == GL_TRUE;
+}
+
+static double Ms(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Asynchronous link
+
+GLuint LinkProgramCachedAsync(const char **vCode, const char **tcCode, const char **teCode, const char **gCode, const char **pCode) {
+	Clock::time_point start = Clock::now();
+	const char **codes[] = { vCode, tcCode, teCode, gCode, pCode };
+	Pending p;
+	for (int i = 0; i < 5; i++)
+		if ((p.stages[i] = codes[i] != NULL))
+			p.sources[i] = *codes[i];
+	GLint nFormats = 0;
+	if (glProgramBinary)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nFormats);
+	p.retrievable = nFormats > 0;
+	p.driver = DriverString();
+	unsigned long long h = 14695981039346656037ull;
+	for (const char **c : codes)
+		Hash(h, c ? *c : NULL);
+	Hash(h, p.driver.c_str());
+	char filename[512];
+	snprintf(filename, sizeof(filename), "%s/%016llx.bin", cacheDir.c_str(), h);
+	p.filename = filename;
+	GLuint program = glCreateProgram();
+	// warm: load binary; cold: compile from source
+	GLenum format = 0;
+	std::vector<char> binary;
+	p.fromBinary = p.retrievable && ReadBinary(filename, p.driver, format, binary);
+	if (p.fromBinary)
+		glProgramBinary(program, format, binary.data(), (GLsizei) binary.size());
+	else
+		IssueCompile(p, program);
+	p.ms = Ms(start);
+	pending[program] = p;
+	return program;
+}
+
+GLuint LinkProgramCachedAsync(const char **vCode, const char **pCode) {
+	return LinkProgramCachedAsync(vCode, NULL, NULL, NULL, pCode);
+}
+
+bool ProgramReady(GLuint program) {
+	if (!parallel || pending.find(program) == pending.end())
+		return true;  // without parallel compile, AwaitProgram compiles in the caller regardless
+	GLint done = GL_FALSE;
+	glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+	return done == GL_TRUE;
+}
+
+GLuint AwaitProgram(GLuint &program) {
+	auto it = pending.find(program);
+	if (it == pending.end())
+		return program;
+	Clock::time_point start = Clock::now();
+	Pending &p = it->second;
+	bool ok = Linked(program), hit = ok && p.fromBinary;
+	if (!ok && p.fromBinary) {
+		// binary rejected by driver (e.g. updated in place): recompile, now blocking
+		glDeleteProgram(program);
+		program = glCreateProgram();
+		IssueCompile(p, program);
+		ok = Linked(program);
+	}
+	if (ok && !hit && p.retrievable)
+		WriteBinary(p.filename.c_str(), p.driver, program);
+	if (!ok) {
+		PrintErrors(p, program);
+		glDeleteProgram(program);
+	}
+	for (GLuint s : p.shaders)
+		if (s)
+			glDeleteShader(s);
+	double wait = Ms(start);
+	(hit ? stats.hits : stats.misses)++;
+	(hit ? stats.hitMs : stats.missMs) += p.ms + wait;
+	stats.waitMs += wait;
+	pending.erase(it);
+	if (!ok)
+		program = 0;
+	return program;
+}
+
+// Synchronous link
+
+GLuint LinkProgramCached(const char **vCode, const char **tcCode, const char **teCode, const char **gCode, const char **pCode) {
+	GLuint program = LinkProgramCachedAsync(vCode, tcCode, teCode, gCode, pCode);
+	return AwaitProgram(program);
+}
+
+GLuint LinkProgramCached(const char **vCode, const char **pCode) {
+	return LinkProgramCached(vCode, NULL, NULL, NULL, pCode);
+}
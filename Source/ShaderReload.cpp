@@ -0,0 +1,221 @@
+// ShaderReload.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <chrono>
+#include <stdio.h>
+#include <sys/stat.h>
+#include "ProgramCache.h"
+#include "ShaderReload.h"
+#ifdef _WIN32
+#include <direct.h>
+#define MakeDirectory(d) _mkdir(d)
+#else
+#define MakeDirectory(d) mkdir(d, 0755)
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+static bool ReadFile(const std::string &path, std::string &text) {
+	FILE *in = fopen(path.c_str(), "rb");
+	if (!in)
+		return false;
+	text.clear();
+	char buf[4096];
+	for (size_t n; (n = fread(buf, 1, sizeof(buf), in)) > 0; )
+		text.append(buf, n);
+	fclose(in);
+	return true;
+}
+
+static long long ModifiedTime(const std::string &path) {
+	struct stat s;
+	return stat(path.c_str(), &s) ? 0 : (long long) s.st_mtime;
+}
+
+// Setup
+
+bool ShaderReload::Start(const char *d) {
+	Stop();
+	dir = d;
+	// make each level of path
+	for (size_t i = 1; i <= dir.size(); i++)
+		if (i == dir.size() || dir[i] == '/')
+			MakeDirectory(dir.substr(0, i).c_str());
+	struct stat s;
+	if (stat(dir.c_str(), &s)) {
+		printf("can't make shader directory %s\n", d);
+		return false;
+	}
+	running = true;
+	watcher = std::thread(&ShaderReload::Watch, this);
+	return true;
+}
+
+void ShaderReload::Stop() {
+	running = false;
+	if (watcher.joinable())
+		watcher.join();
+	for (Target &t : targets)
+		if (t.next && AwaitProgram(t.next))
+			glDeleteProgram(t.next);
+	targets.clear();
+}
+
+const char *ShaderReload::Source(const char *file, const char *code) {
+	std::string path = Path(file), &text = sources[file];
+	if (!ReadFile(path, text)) {
+		text = code;
+		FILE *out = fopen(path.c_str(), "wb");
+		if (out) {
+			fwrite(text.data(), 1, text.size(), out);
+			fclose(out);
+		}
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	files[file] = ModifiedTime(path);
+	return text.c_str();
+}
+
+void ShaderReload::Add(GLuint *program, const char *vFile, const char *pFile) {
+	Target t;
+	t.program = program;
+	t.vFile = vFile;
+	t.pFile = pFile;
+	targets.push_back(t);
+}
+
+void ShaderReload::Add(ShaderVariants *variants, const char *vFile, const char *pFile) {
+	Target t;
+	t.variants = variants;
+	t.vFile = vFile;
+	t.pFile = pFile;
+	targets.push_back(t);
+}
+
+// Watcher thread: read each watched file as it is saved
+
+void ShaderReload::Changed(const std::string &file) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (files.find(file) == files.end())
+			return;
+	}
+	std::string text;
+	if (!ReadFile(Path(file), text) || text.empty())
+		return;  // mid-save; a later event will have the rest
+	std::lock_guard<std::mutex> lock(mutex);
+	changed[file] = text;
+}
+
+void ShaderReload::Watch() {
+#ifdef __linux__
+	int fd = inotify_init1(IN_NONBLOCK);
+	if (fd >= 0 && inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0) {
+		// editors save in place (close after write) or by renaming a temporary over the file
+		alignas(struct inotify_event) char buf[4096];
+		while (running) {
+			pollfd p = { fd, POLLIN, 0 };
+			if (poll(&p, 1, 100) <= 0)
+				continue;
+			ssize_t n = read(fd, buf, sizeof(buf));
+			for (char *e = buf; n > 0 && e < buf + n; ) {
+				struct inotify_event *event = (struct inotify_event *) e;
+				if (event->len)
+					Changed(event->name);
+				e += sizeof(struct inotify_event) + event->len;
+			}
+		}
+		close(fd);
+		return;
+	}
+	if (fd >= 0)
+		close(fd);
+#endif
+	// no inotify: poll modification times
+	while (running) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		std::vector<std::string> edited;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (auto &f : files) {
+				long long t = ModifiedTime(Path(f.first));
+				if (t != f.second) {
+					f.second = t;
+					edited.push_back(f.first);
+				}
+			}
+		}
+		for (std::string &f : edited)
+			Changed(f);
+	}
+}
+
+// Main thread: relink, then swap once linked
+
+void ShaderReload::Retire(GLuint program) {
+	if (retired)
+		retired(program);
+	if (AwaitProgram(program))
+		glDeleteProgram(program);
+}
+
+int ShaderReload::Poll() {
+	std::unordered_map<std::string, std::string> edits;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		edits.swap(changed);
+	}
+	for (auto &e : edits) {
+		std::string &text = sources[e.first];
+		if (text == e.second)
+			continue;
+		text = e.second;
+		printf("%s changed, relinking\n", e.first.c_str());
+		for (Target &t : targets) {
+			if (t.vFile != e.first && t.pFile != e.first)
+				continue;
+			const char *v = sources[t.vFile].c_str(), *p = sources[t.pFile].c_str();
+			if (t.variants)
+				t.variants->Reload(v, p);
+			else {
+				if (t.next && AwaitProgram(t.next))
+					glDeleteProgram(t.next);  // superseded
+				t.next = LinkProgramCachedAsync(&v, &p);
+			}
+		}
+	}
+	int swapped = 0;
+	for (Target &t : targets) {
+		int result = 0;
+		if (t.variants) {
+			std::vector<GLuint> old;
+			result = t.variants->Swap(old);
+			for (GLuint p : old)
+				Retire(p);
+		}
+		else if (t.next && ProgramReady(t.next)) {
+			GLuint old = *t.program;
+			result = AwaitProgram(t.next) ? 1 : -1;
+			if (result > 0) {
+				*t.program = t.next;
+				if (old)
+					Retire(old);
+			}
+			else
+				printf("can't link %s + %s, keeping previous\n", t.vFile.c_str(), t.pFile.c_str());
+			t.next = 0;
+		}
+		if (result > 0) {
+			printf("swapped in %s + %s\n", t.vFile.c_str(), t.pFile.c_str());
+			reloads++;
+			swapped++;
+		}
+		if (result < 0)
+			failures++;
+	}
+	return swapped;
+}
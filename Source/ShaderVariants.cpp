@@ -0,0 +1,107 @@
+// ShaderVariants.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <stdio.h>
+#include "ProgramCache.h"
+#include "ShaderVariants.h"
+
+ShaderVariants::ShaderVariants(const char *v, const char *p, std::vector<const char *> f) : vCode(v), pCode(p) {
+	for (const char *s : f)
+		flags.push_back(s);
+}
+
+std::string ShaderVariants::Name(unsigned int key) const {
+	std::string name;
+	for (size_t i = 0; i < flags.size(); i++)
+		if (key & (1u << i))
+			name += (name.empty() ? "" : "|") + flags[i];
+	return name.empty() ? "none" : name;
+}
+
+std::string ShaderVariants::Specialize(const std::string &code, unsigned int key) const {
+	// defines must follow #version, which must precede all else
+	std::string defines;
+	for (size_t i = 0; i < flags.size(); i++)
+		if (key & (1u << i))
+			defines += "#define " + flags[i] + " 1\n";
+	size_t version = code.find("#version"), at = 0;
+	if (version != std::string::npos) {
+		size_t eol = code.find('\n', version);
+		at = eol == std::string::npos ? code.size() : eol + 1;
+	}
+	std::string s = code;
+	return s.insert(at, (at == s.size() && at ? "\n" : "") + defines);
+}
+
+void ShaderVariants::Prepare(unsigned int key) {
+	if (programs.find(key) != programs.end())
+		return;
+	std::string v = Specialize(vCode, key), p = Specialize(pCode, key);
+	const char *vc = v.c_str(), *pc = p.c_str();   // copied by LinkProgramCachedAsync
+	programs[key] = LinkProgramCachedAsync(&vc, &pc);
+}
+
+GLuint ShaderVariants::Program(unsigned int key) {
+	auto it = programs.find(key);
+	if (it == programs.end()) {
+		Prepare(key);
+		it = programs.find(key);
+	}
+	GLuint &program = it->second;
+	if (program && !AwaitProgram(program))
+		printf("can't link shader variant %s\n", Name(key).c_str());
+	return program;
+}
+
+// Reload
+
+void ShaderVariants::Discard() {
+	for (auto &n : next)
+		if (AwaitProgram(n.second))
+			glDeleteProgram(n.second);
+	next.clear();
+}
+
+void ShaderVariants::Reload(const char *v, const char *p) {
+	Discard(); // a reload still linking is superseded
+	if (programs.empty()) {
+		vCode = v;
+		pCode = p;
+		return;
+	}
+	vNext = v;
+	pNext = p;
+	for (auto &prog : programs) {
+		std::string vs = Specialize(vNext, prog.first), ps = Specialize(pNext, prog.first);
+		const char *vc = vs.c_str(), *pc = ps.c_str();
+		next[prog.first] = LinkProgramCachedAsync(&vc, &pc);
+	}
+}
+
+int ShaderVariants::Swap(std::vector<GLuint> &retired) {
+	if (next.empty())
+		return 0;
+	for (auto &n : next)
+		if (!ProgramReady(n.second))
+			return 0;
+	bool ok = true;
+	for (auto &n : next)
+		if (!AwaitProgram(n.second)) {
+			printf("can't link shader variant %s, keeping previous\n", Name(n.first).c_str());
+			ok = false;
+		}
+	if (!ok) {
+		Discard();
+		return -1;
+	}
+	for (auto &prog : programs) {
+		if (prog.second)
+			retired.push_back(prog.second);
+		prog.second = next[prog.first];
+	}
+	next.clear();
+	vCode = vNext;
+	pCode = pNext;
+	return 1;
+}
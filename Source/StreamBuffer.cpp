@@ -0,0 +1,97 @@
+// StreamBuffer.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <string.h>
+#include "StreamBuffer.h"
+
+StreamBuffer::StreamBuffer(GLenum target, int bytesPerFrame, int nFrames)
+	: target(target), bytesPerFrame(bytesPerFrame), nFrames(nFrames), fences(nFrames, (GLsync) NULL) { }
+
+StreamBuffer::~StreamBuffer() {
+	// GL objects must be freed by Release while context is current
+}
+
+bool StreamBuffer::Init() {
+	glGenBuffers(1, &buffer);
+	glBindBuffer(target, buffer);
+	persistent = glBufferStorage != NULL && glMapBufferRange != NULL;
+	if (persistent) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLsizeiptr size = (GLsizeiptr) bytesPerFrame * nFrames;
+		glBufferStorage(target, size, NULL, flags);
+		mapped = (char *) glMapBufferRange(target, 0, size, flags);
+		persistent = mapped != NULL;
+	}
+	if (!persistent) {
+		// orphaning fallback: single frame-sized store, replaced each frame
+		glBufferData(target, bytesPerFrame, NULL, GL_STREAM_DRAW);
+		staging.resize(bytesPerFrame);
+	}
+	return buffer != 0;
+}
+
+void StreamBuffer::Release() {
+	for (GLsync &f : fences)
+		if (f) {
+			glDeleteSync(f);
+			f = NULL;
+		}
+	if (buffer) {
+		if (mapped) {
+			glBindBuffer(target, buffer);
+			glUnmapBuffer(target);
+			mapped = NULL;
+		}
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+}
+
+void StreamBuffer::BeginFrame() {
+	head = committed = 0;
+	if (!persistent) {
+		// orphan: driver hands out fresh storage, no wait on pending draws
+		glBindBuffer(target, buffer);
+		glBufferData(target, bytesPerFrame, NULL, GL_STREAM_DRAW);
+		return;
+	}
+	GLsync &f = fences[frame];
+	if (f) {
+		// region last written nFrames ago; usually already signaled
+		GLenum status = glClientWaitSync(f, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED) {
+			stalls++;
+			while (status == GL_TIMEOUT_EXPIRED)
+				status = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+		glDeleteSync(f);
+		f = NULL;
+	}
+}
+
+void *StreamBuffer::Alloc(int nBytes, GLintptr &offset, int align) {
+	int start = (head + align - 1) / align * align;
+	if (start + nBytes > bytesPerFrame)
+		return NULL;
+	head = start + nBytes;
+	offset = RegionStart() + start;
+	return persistent ? mapped + offset : staging.data() + start;
+}
+
+void StreamBuffer::Commit() {
+	// persistent mapping is coherent: writes are visible to subsequent draws
+	if (!persistent && head > committed) {
+		glBindBuffer(target, buffer);
+		glBufferSubData(target, committed, head - committed, staging.data() + committed);
+	}
+	committed = head;
+}
+
+void StreamBuffer::EndFrame() {
+	Commit();
+	if (persistent) {
+		fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		frame = (frame + 1) % nFrames;
+	}
+}
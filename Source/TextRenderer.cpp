@@ -0,0 +1,572 @@
+// TextRenderer.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include "GLXtras.h"
+#include "ProgramCache.h"
+#include "TextRenderer.h"
+
+// Shaders: glyph vertices pulled from buffer texture, per-instance transform rows
+
+static const char *vTextShader = R"(
+	#version 140
+	in vec4 row0, row1, row2, row3;     // per instance: transform, row-major
+	in vec4 tint;                       // per instance: rgb, glyph slot
+	out vec3 vColor;
+	uniform samplerBuffer glyphVertices;
+	uniform int maxVertices;
+	uniform mat4 view;
+	void main() {
+		int v = 2*(int(tint.w)*maxVertices+gl_VertexID);
+		vec4 p = vec4(texelFetch(glyphVertices, v).xyz, 1);
+		gl_Position = view*vec4(dot(row0, p), dot(row1, p), dot(row2, p), dot(row3, p));
+		vColor = texelFetch(glyphVertices, v+1).rgb*tint.rgb;
+	}
+)";
+
+static const char *pTextShader = R"(
+	#version 140
+	in vec3 vColor;
+	out vec4 pColor;
+	void main() {
+		pColor = vec4(vColor, 1);
+	}
+)";
+
+// Distance field shaders: instance quad from gl_VertexID, coverage by smoothstep across the edge
+
+static const char *vFieldShader = R"(
+	#version 140
+	in vec4 row0, row1, row2, row3;     // per instance: transform, row-major
+	in vec4 tint;                       // per instance: rgb, glyph slot
+	in vec4 box;                        // per instance: glyph space covered by the glyph's atlas texels
+	out vec2 uv;
+	out vec3 vTint;
+	uniform vec2 cellSize;              // atlas cell pitch, in texture coordinates
+	uniform vec2 unitSize;              // glyph space unit, in texture coordinates
+	uniform int columns;
+	uniform mat4 view;
+	void main() {
+		vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);  // triangle strip
+		int slot = int(tint.w);
+		vec4 p = vec4(mix(box.xy, box.zw, corner), 0, 1);
+		uv = vec2(slot % columns, slot / columns)*cellSize+corner*(box.zw-box.xy)*unitSize;
+		vTint = tint.rgb;
+		gl_Position = view*vec4(dot(row0, p), dot(row1, p), dot(row2, p), dot(row3, p));
+	}
+)";
+
+static const char *pFieldShader = R"(
+	#version 140
+	in vec2 uv;
+	in vec3 vTint;
+	out vec4 pColor;
+	uniform sampler2D atlas;            // rgb: nearest mesh color, a: distance
+	void main() {
+		vec4 field = texture(atlas, uv);
+		float d = field.a, w = max(fwidth(d), 1e-4);
+		float a = smoothstep(.5-w, .5+w, d);
+		if (a < .01)
+			discard;
+		pColor = vec4(field.rgb*vTint, a);
+	}
+)";
+
+// 5x7 font, ASCII 32-126: five columns per glyph, bit 0 the top row, bit 7 a descender row
+
+static const unsigned char font[95][5] = {
+	{0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},  //  !"#
+	{0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x56,0x20,0x50}, {0x00,0x08,0x07,0x03,0x00},  // $%&'
+	{0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x2A,0x1C,0x7F,0x1C,0x2A}, {0x08,0x08,0x3E,0x08,0x08},  // ()*+
+	{0x00,0x80,0x70,0x30,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x00,0x60,0x60,0x00}, {0x20,0x10,0x08,0x04,0x02},  // ,-./
+	{0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x72,0x49,0x49,0x49,0x46}, {0x21,0x41,0x49,0x4D,0x33},  // 0123
+	{0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x31}, {0x41,0x21,0x11,0x09,0x07},  // 4567
+	{0x36,0x49,0x49,0x49,0x36}, {0x46,0x49,0x49,0x29,0x1E}, {0x00,0x00,0x14,0x00,0x00}, {0x00,0x40,0x34,0x00,0x00},  // 89:;
+	{0x00,0x08,0x14,0x22,0x41}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x59,0x09,0x06},  // <=>?
+	{0x3E,0x41,0x5D,0x59,0x4E}, {0x7C,0x12,0x11,0x12,0x7C}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},  // @ABC
+	{0x7F,0x41,0x41,0x41,0x3E}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x41,0x51,0x73},  // DEFG
+	{0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},  // HIJK
+	{0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x1C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},  // LMNO
+	{0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x26,0x49,0x49,0x49,0x32},  // PQRS
+	{0x03,0x01,0x7F,0x01,0x03}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},  // TUVW
+	{0x63,0x14,0x08,0x14,0x63}, {0x03,0x04,0x78,0x04,0x03}, {0x61,0x59,0x49,0x4D,0x43}, {0x00,0x7F,0x41,0x41,0x41},  // XYZ[
+	{0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x41,0x7F}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},  // \]^_
+	{0x00,0x03,0x07,0x08,0x00}, {0x20,0x54,0x54,0x78,0x40}, {0x7F,0x28,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x28},  // `abc
+	{0x38,0x44,0x44,0x28,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x00,0x08,0x7E,0x09,0x02}, {0x18,0xA4,0xA4,0x9C,0x78},  // defg
+	{0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x40,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},  // hijk
+	{0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x78,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},  // lmno
+	{0xFC,0x18,0x24,0x24,0x18}, {0x18,0x24,0x24,0x18,0xFC}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x24},  // pqrs
+	{0x04,0x04,0x3F,0x44,0x24}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},  // tuvw
+	{0x44,0x28,0x10,0x28,0x44}, {0x4C,0x90,0x90,0x90,0x7C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},  // xyz{
+	{0x00,0x00,0x77,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x02,0x01,0x02,0x04,0x02}                               // |}~
+};
+
+static const float CELL = 1.f / 7.f;
+
+// Distance field atlas: each glyph's texels cover its bounds plus SDF_SPREAD texels of field around
+// them, from the corner of a cell sized to the largest glyph
+static const int SDF_SCALE = 28;                                // texels per glyph height
+static const int SDF_SPREAD = 8;                                // texels, distance mapped to [0, 1]
+static const int SDF_SUPERSAMPLE = 4;                           // coverage samples per texel, each way
+static const int SDF_COLUMNS = 16;                              // cells per atlas row
+
+typedef std::chrono::steady_clock Clock;
+
+// gradient across glyph box, as the hand-built letters were colored
+static vec3 GlyphColor(float x, float y) {
+	float u = x / (5 * CELL), v = y < 0 ? 0 : y > 1 ? 1 : y;
+	vec3 top = vec3(1, 0, 0) + u * (vec3(1, 0, 1) - vec3(1, 0, 0));
+	vec3 bottom = vec3(0, 1, 1) + u * (vec3(1, 1, 0) - vec3(0, 1, 1));
+	return bottom + v * (top - bottom);
+}
+
+// Setup
+
+TextRenderer::TextRenderer(int textureUnit, int maxGlyphs)
+	: stream(GL_ARRAY_BUFFER, maxGlyphs * (int) sizeof(Instance)), textureUnit(textureUnit), maxGlyphs(maxGlyphs) { }
+
+bool TextRenderer::Init() {
+	if (!stream.Init())
+		return false;
+	BuildFont();
+	glGenBuffers(1, &vertexBuffer);
+	glGenTextures(1, &vertexTexture);
+	programs[0] = LinkProgramCachedAsync(&vTextShader, &pTextShader);
+	programs[1] = LinkProgramCachedAsync(&vFieldShader, &pFieldShader);
+	return programs[0] && programs[1];
+}
+
+void TextRenderer::Release() {
+	stream.Release();
+	glDeleteBuffers(1, &vertexBuffer);
+	glDeleteTextures(1, &vertexTexture);
+	glDeleteTextures(1, &atlas);
+	for (int m = 0; m < 2; m++) {
+		glDeleteProgram(programs[m]);
+		programs[m] = 0;
+		attributes[m][0] = -1;
+	}
+	vertexBuffer = vertexTexture = atlas = 0;
+	stale = atlasStale = true;
+}
+
+void TextRenderer::BuildFont() {
+	// merge each column's vertical runs of lit cells with identical runs in following columns
+	struct Run { int r0, r1, c0; };
+	for (int code = 32; code < 127; code++) {
+		const unsigned char *columns = font[code - 32];
+		std::vector<vec3> points, colors;
+		std::vector<int3> triangles;
+		std::vector<Run> open;
+		for (int c = 0; c <= 5; c++) {
+			std::vector<Run> runs;
+			for (int r = 0; c < 5 && r < 8; r++)
+				if (columns[c] >> r & 1) {
+					int r0 = r;
+					while (r < 8 && columns[c] >> r & 1)
+						r++;
+					runs.push_back({ r0, r, c });
+				}
+			std::vector<Run> next;
+			for (Run o : open) {
+				bool continued = false;
+				for (size_t i = 0; i < runs.size() && !continued; i++)
+					if (runs[i].r0 == o.r0 && runs[i].r1 == o.r1) {
+						runs.erase(runs.begin() + i);
+						continued = true;
+					}
+				if (continued) {
+					next.push_back(o);
+					continue;
+				}
+				// close rectangle: columns o.c0 to c, rows o.r0 to o.r1 (row 7 is below baseline)
+				float x0 = o.c0 * CELL, x1 = c * CELL, y0 = (7 - o.r1) * CELL, y1 = (7 - o.r0) * CELL;
+				int n = (int) points.size();
+				vec3 corners[] = { vec3(x0, y0, 0), vec3(x1, y0, 0), vec3(x1, y1, 0), vec3(x0, y1, 0) };
+				for (vec3 p : corners) {
+					points.push_back(p);
+					colors.push_back(GlyphColor(p.x, p.y));
+				}
+				triangles.push_back(int3(n, n + 1, n + 2));
+				triangles.push_back(int3(n, n + 2, n + 3));
+			}
+			next.insert(next.end(), runs.begin(), runs.end());
+			open = next;
+		}
+		AddGlyph(code, points.data(), colors.data(), (int) points.size(), triangles.data(), (int) triangles.size(), 6 * CELL);
+	}
+}
+
+void TextRenderer::AddGlyph(int code, const vec3 *points, const vec3 *colors, int nPoints,
+							const int3 *triangles, int nTriangles, float advance) {
+	auto s = slots.find(code);
+	if (s == slots.end()) {
+		s = slots.insert({ code, (int) meshes.size() }).first;
+		meshes.push_back(Mesh());
+	}
+	Mesh &m = meshes[s->second];
+	m.points.clear();
+	m.colors.clear();
+	for (int t = 0; t < nTriangles; t++)
+		for (int i : { triangles[t].i1, triangles[t].i2, triangles[t].i3 }) {
+			m.points.push_back(points[i]);
+			m.colors.push_back(colors[i]);
+		}
+	m.advance = advance;
+	m.bounds = BoundingBox(m.points);  // only the points its triangles use
+	// distance field texels over the bounds plus spread, and the glyph space they cover
+	float pad = (float) SDF_SPREAD / SDF_SCALE;
+	m.fieldWidth = (int) ceil((m.bounds.max.x - m.bounds.min.x) * SDF_SCALE) + 2 * SDF_SPREAD;
+	m.fieldHeight = (int) ceil((m.bounds.max.y - m.bounds.min.y) * SDF_SCALE) + 2 * SDF_SPREAD;
+	m.box = vec4(m.bounds.min.x - pad, m.bounds.min.y - pad,
+				 m.bounds.min.x - pad + (float) m.fieldWidth / SDF_SCALE, m.bounds.min.y - pad + (float) m.fieldHeight / SDF_SCALE);
+	stale = atlasStale = true;
+}
+
+void TextRenderer::UploadGlyphs() {
+	// two RGBA32F texels per vertex (position, color); shorter glyphs padded with degenerate vertices
+	maxVertices = 3;
+	for (const Mesh &m : meshes)
+		maxVertices = (int) m.points.size() > maxVertices ? (int) m.points.size() : maxVertices;
+	std::vector<float> texels(meshes.size() * maxVertices * 8, 0.f);
+	for (size_t g = 0; g < meshes.size(); g++)
+		for (size_t v = 0; v < meshes[g].points.size(); v++) {
+			float *t = &texels[(g * maxVertices + v) * 8];
+			vec3 p = meshes[g].points[v], c = meshes[g].colors[v];
+			float texel[8] = { p.x, p.y, p.z, 1, c.x, c.y, c.z, 1 };
+			memcpy(t, texel, sizeof(texel));
+		}
+	glBindBuffer(GL_TEXTURE_BUFFER, vertexBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, texels.size() * sizeof(float), texels.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_BUFFER, vertexTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, vertexBuffer);
+	stale = false;
+}
+
+// Distance field atlas
+
+template <typename F>
+static void ParallelGlyphs(int nGlyphs, F glyph) {
+	int n = (int) std::thread::hardware_concurrency();
+	n = n < 1 ? 1 : n < nGlyphs ? n : nGlyphs;
+	std::vector<std::thread> threads;
+	for (int t = 1; t < n; t++)
+		threads.push_back(std::thread([&, t]() {
+			for (int g = t; g < nGlyphs; g += n)
+				glyph(g);
+		}));
+	for (int g = 0; g < nGlyphs; g += n)
+		glyph(g);
+	for (std::thread &t : threads)
+		t.join();
+}
+
+static const float FAR = 1e20f;
+
+// squared distance to nearest feature (f = 0) along a line, lower envelope of parabolas (Felzenszwalb)
+static void DistanceLine(const float *f, float *d, int n, std::vector<int> &v, std::vector<float> &z) {
+	int k = 0;
+	v[0] = 0;
+	z[0] = -FAR;
+	z[1] = FAR;
+	for (int q = 1; q < n; q++) {
+		float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+		while (s <= z[k]) {
+			k--;
+			s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+		}
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = FAR;
+	}
+	k = 0;
+	for (int q = 0; q < n; q++) {
+		while (z[k + 1] < q)
+			k++;
+		d[q] = (float) (q - v[k]) * (q - v[k]) + f[v[k]];
+	}
+}
+
+// squared distance of each sample to the nearest sample where feature[i] is set
+static std::vector<float> DistanceField(const std::vector<char> &feature, int w, int h) {
+	std::vector<float> d(w * h), f(w > h ? w : h), out(w > h ? w : h), z((w > h ? w : h) + 1);
+	std::vector<int> v(w > h ? w : h);
+	for (int i = 0; i < w * h; i++)
+		d[i] = feature[i] ? 0 : FAR;
+	for (int x = 0; x < w; x++) {
+		for (int y = 0; y < h; y++)
+			f[y] = d[y * w + x];
+		DistanceLine(f.data(), out.data(), h, v, z);
+		for (int y = 0; y < h; y++)
+			d[y * w + x] = out[y];
+	}
+	for (int y = 0; y < h; y++) {
+		DistanceLine(&d[y * w], out.data(), w, v, z);
+		memcpy(&d[y * w], out.data(), w * sizeof(float));
+	}
+	return d;
+}
+
+// color of a triangle list nearest (x, y): interpolated inside a triangle, else at the closest edge point
+static vec3 NearestColor(const std::vector<vec3> &p, const std::vector<vec3> &colors, float x, float y) {
+	float nearest = FAR;
+	vec3 color(0, 0, 0);
+	for (size_t t = 0; t + 2 < p.size(); t += 3) {
+		vec3 a = p[t], b = p[t + 1], c = p[t + 2];
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (area == 0)
+			continue;
+		float wa = ((b.x - x) * (c.y - y) - (b.y - y) * (c.x - x)) / area;
+		float wb = ((c.x - x) * (a.y - y) - (c.y - y) * (a.x - x)) / area;
+		float wc = 1 - wa - wb;
+		if (wa >= 0 && wb >= 0 && wc >= 0)
+			return wa * colors[t] + wb * colors[t + 1] + wc * colors[t + 2];
+		for (int e = 0; e < 3; e++) {
+			int i = (int) t + e, j = (int) t + (e + 1) % 3;
+			float dx = p[j].x - p[i].x, dy = p[j].y - p[i].y, len2 = dx * dx + dy * dy;
+			float s = len2 > 0 ? ((x - p[i].x) * dx + (y - p[i].y) * dy) / len2 : 0;
+			s = s < 0 ? 0 : s > 1 ? 1 : s;
+			float ex = p[i].x + s * dx - x, ey = p[i].y + s * dy - y, d2 = ex * ex + ey * ey;
+			if (d2 < nearest) {
+				nearest = d2;
+				color = (1 - s) * colors[i] + s * colors[j];
+			}
+		}
+	}
+	return color;
+}
+
+void TextRenderer::BuildAtlas() {
+	// per glyph: rasterize triangles into supersampled coverage, distance transform inside and
+	// outside, sample signed distance (texels) at glyph texel centers into alpha, with the color
+	// of the nearest mesh point, so quads are colored as the meshes are
+	Clock::time_point start = Clock::now();
+	int nGlyphs = (int) meshes.size(), rows = (nGlyphs + SDF_COLUMNS - 1) / SDF_COLUMNS;
+	cellWidth = cellHeight = 1;
+	for (const Mesh &m : meshes) {
+		cellWidth = m.fieldWidth > cellWidth ? m.fieldWidth : cellWidth;
+		cellHeight = m.fieldHeight > cellHeight ? m.fieldHeight : cellHeight;
+	}
+	atlasWidth = SDF_COLUMNS * cellWidth;
+	atlasHeight = rows * cellHeight;
+	std::vector<unsigned char> texels(4 * atlasWidth * atlasHeight, 0);
+	ParallelGlyphs(nGlyphs, [&](int g) {
+		const Mesh &m = meshes[g];
+		const int ss = SDF_SUPERSAMPLE, w = m.fieldWidth * ss, h = m.fieldHeight * ss;
+		const float perUnit = (float) (SDF_SCALE * ss);
+		std::vector<char> inside(w * h, 0), outside(w * h, 1);
+		const std::vector<vec3> &p = m.points;
+		for (size_t t = 0; t + 2 < p.size(); t += 3) {
+			vec2 a((p[t].x - m.box.x) * perUnit, (p[t].y - m.box.y) * perUnit);
+			vec2 b((p[t + 1].x - m.box.x) * perUnit, (p[t + 1].y - m.box.y) * perUnit);
+			vec2 c((p[t + 2].x - m.box.x) * perUnit, (p[t + 2].y - m.box.y) * perUnit);
+			float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+			if (area == 0)
+				continue;
+			int x0 = (int) floor(fmin(a.x, fmin(b.x, c.x))), x1 = (int) ceil(fmax(a.x, fmax(b.x, c.x)));
+			int y0 = (int) floor(fmin(a.y, fmin(b.y, c.y))), y1 = (int) ceil(fmax(a.y, fmax(b.y, c.y)));
+			x0 = x0 < 0 ? 0 : x0; y0 = y0 < 0 ? 0 : y0;
+			x1 = x1 > w ? w : x1; y1 = y1 > h ? h : y1;
+			for (int y = y0; y < y1; y++)
+				for (int x = x0; x < x1; x++) {
+					// sample center against edges, either winding
+					float sx = x + .5f, sy = y + .5f;
+					float e0 = (b.x - a.x) * (sy - a.y) - (b.y - a.y) * (sx - a.x);
+					float e1 = (c.x - b.x) * (sy - b.y) - (c.y - b.y) * (sx - b.x);
+					float e2 = (a.x - c.x) * (sy - c.y) - (a.y - c.y) * (sx - c.x);
+					if (area > 0 ? e0 >= 0 && e1 >= 0 && e2 >= 0 : e0 <= 0 && e1 <= 0 && e2 <= 0)
+						inside[y * w + x] = 1, outside[y * w + x] = 0;
+				}
+		}
+		std::vector<float> toInside = DistanceField(inside, w, h), toOutside = DistanceField(outside, w, h);
+		int cellX = (g % SDF_COLUMNS) * cellWidth, cellY = (g / SDF_COLUMNS) * cellHeight;
+		for (int y = 0; y < m.fieldHeight; y++)
+			for (int x = 0; x < m.fieldWidth; x++) {
+				int i = (y * ss + ss / 2) * w + x * ss + ss / 2;
+				float d = inside[i] ? sqrtf(toOutside[i]) - .5f : .5f - sqrtf(toInside[i]);
+				float v = .5f + d / ss / (2 * SDF_SPREAD);
+				v = v < 0 ? 0 : v > 1 ? 1 : v;
+				vec3 color = NearestColor(p, m.colors, m.box.x + (x + .5f) / SDF_SCALE, m.box.y + (y + .5f) / SDF_SCALE);
+				unsigned char *t = &texels[4 * ((cellY + y) * atlasWidth + cellX + x)];
+				for (int k = 0; k < 3; k++)
+					t[k] = (unsigned char) (255 * (color[k] < 0 ? 0 : color[k] > 1 ? 1 : color[k]) + .5f);
+				t[3] = (unsigned char) (255 * v + .5f);
+			}
+	});
+	if (!atlas)
+		glGenTextures(1, &atlas);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+	// mips only while the spread keeps neighboring cells apart
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 3);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	atlasStale = false;
+	atlasMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Layout
+
+const TextRenderer::Mesh *TextRenderer::Find(int code) const {
+	auto s = slots.find(code);
+	return s == slots.end() ? NULL : &meshes[s->second];
+}
+
+float TextRenderer::Advance(int code) const {
+	const Mesh *m = Find(code);
+	return m ? m->advance : 6 * CELL;
+}
+
+float TextRenderer::Width(const char *s) const {
+	// advance of all but the last glyph, plus the last glyph's extent
+	float w = 0;
+	for (; *s; s++) {
+		const Mesh *m = s[1] ? NULL : Find((unsigned char) *s);
+		w += m && !m->points.empty() ? m->bounds.max.x : Advance((unsigned char) *s);
+	}
+	return w;
+}
+
+AABB TextRenderer::Bounds(const char *s) const {
+	AABB b(vec3(0, 0, 0), vec3(Width(s), 1, 0));
+	for (; *s; s++)
+		if (const Mesh *m = Find((unsigned char) *s))
+			if (m->bounds.min.y < b.min.y)
+				b.min.y = m->bounds.min.y;
+	return b;
+}
+
+mat4 TextRenderer::Center(const char *s) const {
+	return Translate(-.5f * Width(s), -.5f, 0);
+}
+
+// Batching
+
+void TextRenderer::Begin() {
+	instances.clear();
+}
+
+void TextRenderer::Glyph(int code, mat4 m, vec3 tint) {
+	auto s = slots.find(code);
+	if (s == slots.end() || meshes[s->second].points.empty())
+		return;
+	Instance i;
+	for (int r = 0; r < 4; r++)
+		for (int c = 0; c < 4; c++)
+			i.rows[r][c] = m[r][c];
+	float t[4] = { tint.x, tint.y, tint.z, (float) s->second };
+	memcpy(i.tint, t, sizeof(t));
+	vec4 box = meshes[s->second].box;
+	for (int k = 0; k < 4; k++)
+		i.box[k] = box[k];
+	instances.push_back(i);
+}
+
+void TextRenderer::Text(const char *s, mat4 m, vec3 tint) {
+	float x = 0;
+	for (; *s; s++) {
+		int code = (unsigned char) *s;
+		Glyph(code, m * Translate(x, 0, 0), tint);
+		x += Advance(code);
+	}
+}
+
+void TextRenderer::End(mat4 view) {
+	lastGlyphs = (int) instances.size();
+	lastDraws = 0;
+	if (instances.empty())
+		return;
+	int mode = sdf ? 1 : 0;
+	if (sdf ? atlasStale : stale)
+		sdf ? BuildAtlas() : UploadGlyphs();
+	GLuint program = AwaitProgram(programs[mode]);
+	GLint *locations = attributes[mode];
+	glUseProgram(program);
+	if (locations[0] < 0)
+		for (int a = 0; a < 6; a++) {
+			char name[] = "row0";
+			name[3] += a;
+			locations[a] = glGetAttribLocation(program, a < 4 ? name : a < 5 ? "tint" : "box");
+		}
+	SetUniform(program, "view", view);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	// caller's blending, restored after the quads
+	GLboolean blend = glIsEnabled(GL_BLEND);
+	GLint blendFunc[4] = { GL_ONE, GL_ZERO, GL_ONE, GL_ZERO };
+	if (sdf) {
+		SetUniform(program, "atlas", textureUnit);
+		SetUniform(program, "cellSize", vec2((float) cellWidth / atlasWidth, (float) cellHeight / atlasHeight));
+		SetUniform(program, "unitSize", vec2((float) SDF_SCALE / atlasWidth, (float) SDF_SCALE / atlasHeight));
+		SetUniform(program, "columns", SDF_COLUMNS);
+		glBindTexture(GL_TEXTURE_2D, atlas);
+		glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+		glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+		glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+		glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else {
+		SetUniform(program, "maxVertices", maxVertices);
+		SetUniform(program, "glyphVertices", textureUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, vertexTexture);
+	}
+	// one instanced draw per stream region's worth of glyphs (one in all but huge batches)
+	int stride = (int) sizeof(Instance);
+	for (int first = 0; first < lastGlyphs; first += maxGlyphs) {
+		int n = lastGlyphs - first < maxGlyphs ? lastGlyphs - first : maxGlyphs;
+		stream.BeginFrame();
+		GLintptr offset = 0;
+		void *dst = stream.Alloc(n * stride, offset);
+		if (!dst) {
+			stream.EndFrame();
+			break;
+		}
+		memcpy(dst, &instances[first], n * stride);
+		stream.Commit();
+		glBindBuffer(GL_ARRAY_BUFFER, stream.Buffer());
+		for (int a = 0; a < 6; a++)
+			if (locations[a] >= 0) {  // box is unused by glyph meshes
+				glEnableVertexAttribArray(locations[a]);
+				glVertexAttribPointer(locations[a], 4, GL_FLOAT, GL_FALSE, stride, (void *) (offset + 16 * a));
+				glVertexAttribDivisor(locations[a], 1);
+			}
+		if (sdf)
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, n);
+		else
+			glDrawArraysInstanced(GL_TRIANGLES, 0, maxVertices, n);
+		stream.EndFrame();
+		lastDraws++;
+	}
+	if (sdf) {
+		if (!blend)
+			glDisable(GL_BLEND);
+		glBlendFuncSeparate(blendFunc[0], blendFunc[1], blendFunc[2], blendFunc[3]);
+	}
+	// no vertex array objects here: leave attributes as other draws expect them
+	for (int a = 0; a < 6; a++)
+		if (locations[a] >= 0) {
+			glVertexAttribDivisor(locations[a], 0);
+			glDisableVertexAttribArray(locations[a]);
+		}
+}
+
+void TextRenderer::PrintStats(const char *title) const {
+	printf("%s%s%i glyphs in %i draw%s last frame (%s), %i glyph meshes of %i vertices, %i stream stalls\n",
+		   title ? title : "", title ? ": " : "", lastGlyphs, lastDraws, lastDraws == 1 ? "" : "s",
+		   sdf ? "distance field quads" : "meshes", (int) meshes.size(), maxVertices, stream.stalls);
+	if (atlasWidth)
+		printf("%s%sdistance field atlas %ix%i, built in %.1f ms\n", title ? title : "", title ? ": " : "", atlasWidth, atlasHeight, atlasMs);
+}
@@ -0,0 +1,544 @@
+// TextureCache.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include "Misc.h"
+#include "stb_image.h"
+#include "TextureCache.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+#define MakeDirectory(d) _mkdir(d)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define MakeDirectory(d) mkdir(d, 0755)
+#endif
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static std::string cacheDir = "TextureCache";
+static MipFilter mipFilter = MIP_KAISER;
+static TextureCacheStats stats;
+static const unsigned int MAGIC = 0x58545447, VERSION = 1; // 'GTTX'
+
+// Container: header, level table, then level data (each 16-byte aligned)
+
+struct Header {
+	unsigned int magic, version, width, height, levels, format;
+};
+
+struct LevelEntry {
+	unsigned int width, height, offset, size;
+};
+
+void SetTextureCacheDirectory(const char *dir) {
+	cacheDir = dir;
+}
+
+void SetMipFilter(MipFilter filter) {
+	mipFilter = filter;
+}
+
+MipFilter GetMipFilter() {
+	return mipFilter;
+}
+
+TextureCacheStats GetTextureCacheStats() {
+	return stats;
+}
+
+void PrintTextureCacheStats(const char *title) {
+	printf("%s%stextures: %i from cache (%.1f ms), %i converted (%.1f ms), %.1f MB on GPU\n",
+		   title ? title : "", title ? ": " : "", stats.hits, stats.hitMs, stats.misses, stats.missMs, stats.gpuBytes / (1024. * 1024.));
+}
+
+// Mapped file
+
+bool MappedFile::Open(const char *path) {
+	Close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER n;
+	HANDLE map = GetFileSizeEx(file, &n) && n.QuadPart ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	CloseHandle(file);
+	if (!map)
+		return false;
+	data = (const char *) MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+	size = (size_t) n.QuadPart;
+	mapping = map;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat s;
+	void *p = fstat(fd, &s) || !s.st_size ? MAP_FAILED : mmap(NULL, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	data = p == MAP_FAILED ? NULL : (const char *) p;
+	size = data ? (size_t) s.st_size : 0;
+#endif
+	return data != NULL;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle((HANDLE) mapping);
+#else
+	if (data)
+		munmap((void *) data, size);
+#endif
+	data = NULL;
+	mapping = NULL;
+	size = 0;
+}
+
+bool TextureFile::Open(const char *path) {
+	Close();
+	const Header *h = file.Open(path) ? (const Header *) file.data : NULL;
+	size_t size = file.size;
+	bool ok = h && size >= sizeof(Header) && h->magic == MAGIC && h->version == VERSION &&
+			  size >= sizeof(Header) + h->levels * sizeof(LevelEntry);
+	const LevelEntry *l = ok ? (const LevelEntry *) (h + 1) : NULL;
+	for (unsigned int i = 0; ok && i < h->levels; i++)
+		ok = (size_t) l[i].offset + l[i].size <= size;
+	if (!ok) {
+		Close();
+		return false;
+	}
+	width = h->width;
+	height = h->height;
+	levels = h->levels;
+	format = h->format;
+	return true;
+}
+
+void TextureFile::Close() {
+	file.Close();
+	width = height = levels = 0;
+}
+
+const void *TextureFile::Level(int level, int &w, int &h, int &nBytes) const {
+	const LevelEntry &l = ((const LevelEntry *) ((const Header *) file.data + 1))[level];
+	w = l.width;
+	h = l.height;
+	nBytes = l.size;
+	return file.data + l.offset;
+}
+
+int TextureFile::Bytes() const {
+	int sum = 0, w, h, n;
+	for (int i = 0; i < levels; i++) {
+		Level(i, w, h, n);
+		sum += n;
+	}
+	return sum;
+}
+
+// Rows split across hardware threads
+
+template <typename F>
+static void ParallelRows(int nRows, F row) {
+	int n = (int) std::thread::hardware_concurrency();
+	n = n < 1 ? 1 : n < nRows ? n : nRows;
+	std::vector<std::thread> threads;
+	for (int t = 1; t < n; t++)
+		threads.push_back(std::thread([&, t]() {
+			for (int y = t; y < nRows; y += n)
+				row(y);
+		}));
+	for (int y = 0; y < nRows; y += n)
+		row(y);
+	for (std::thread &t : threads)
+		t.join();
+}
+
+// Mip levels
+
+struct Image {
+	int width, height;
+	std::vector<unsigned char> rgba;
+};
+
+static Image Downsample(const Image &src) {
+	// 2x2 box filter (an odd last row or column is folded into its neighbor)
+	Image dst;
+	dst.width = src.width > 1 ? src.width / 2 : 1;
+	dst.height = src.height > 1 ? src.height / 2 : 1;
+	dst.rgba.resize(4 * dst.width * dst.height);
+	ParallelRows(dst.height, [&](int y) {
+		for (int x = 0; x < dst.width; x++) {
+			int x0 = 2 * x < src.width ? 2 * x : src.width - 1, y0 = 2 * y < src.height ? 2 * y : src.height - 1;
+			int x1 = x0 + 1 < src.width ? x0 + 1 : x0, y1 = y0 + 1 < src.height ? y0 + 1 : y0;
+			for (int c = 0; c < 4; c++) {
+				int sum = src.rgba[4 * (y0 * src.width + x0) + c] + src.rgba[4 * (y0 * src.width + x1) + c] +
+						  src.rgba[4 * (y1 * src.width + x0) + c] + src.rgba[4 * (y1 * src.width + x1) + c];
+				dst.rgba[4 * (y * dst.width + x) + c] = (unsigned char) ((sum + 2) / 4);
+			}
+		}
+	});
+	return dst;
+}
+
+// Kaiser-windowed sinc: weights per destination texel, over source texels within the support
+
+static const float KAISER_ALPHA = 4, KAISER_RADIUS = 2;  // radius in destination texels
+
+static double BesselI0(double x) {
+	double sum = 1, term = 1;
+	for (int k = 1; k < 20; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+static float KaiserSinc(float x) {
+	if (fabsf(x) >= KAISER_RADIUS)
+		return 0;
+	float t = x / KAISER_RADIUS, px = 3.14159265f * x;
+	double window = BesselI0(KAISER_ALPHA * sqrt(1 - t * t)) / BesselI0(KAISER_ALPHA);
+	return (float) ((x == 0 ? 1 : sin(px) / px) * window);
+}
+
+struct Taps {
+	int first;
+	std::vector<float> weights;
+};
+
+static std::vector<Taps> KaiserTaps(int src, int dst) {
+	std::vector<Taps> taps(dst);
+	float scale = (float) src / dst;
+	for (int i = 0; i < dst; i++) {
+		float center = (i + .5f) * scale, sum = 0;
+		Taps &t = taps[i];
+		t.first = (int) floorf(center - KAISER_RADIUS * scale);
+		int last = (int) ceilf(center + KAISER_RADIUS * scale);
+		for (int j = t.first; j <= last; j++) {
+			float w = KaiserSinc((j + .5f - center) / scale);
+			t.weights.push_back(w);
+			sum += w;
+		}
+		for (float &w : t.weights)
+			w /= sum;
+	}
+	return taps;
+}
+
+static Image DownsampleKaiser(const Image &src) {
+	// separable: rows into a float image, then columns
+	Image dst;
+	dst.width = src.width > 1 ? src.width / 2 : 1;
+	dst.height = src.height > 1 ? src.height / 2 : 1;
+	dst.rgba.resize(4 * dst.width * dst.height);
+	std::vector<Taps> xTaps = KaiserTaps(src.width, dst.width), yTaps = KaiserTaps(src.height, dst.height);
+	std::vector<float> rows(4 * (size_t) dst.width * src.height);
+	ParallelRows(src.height, [&](int y) {
+		for (int x = 0; x < dst.width; x++) {
+			const Taps &t = xTaps[x];
+			float sum[4] = { 0, 0, 0, 0 };
+			for (size_t k = 0; k < t.weights.size(); k++) {
+				int sx = ((t.first + (int) k) % src.width + src.width) % src.width;
+				const unsigned char *p = &src.rgba[4 * ((size_t) y * src.width + sx)];
+				for (int c = 0; c < 4; c++)
+					sum[c] += t.weights[k] * p[c];
+			}
+			memcpy(&rows[4 * ((size_t) y * dst.width + x)], sum, sizeof(sum));
+		}
+	});
+	ParallelRows(dst.height, [&](int y) {
+		const Taps &t = yTaps[y];
+		for (int x = 0; x < dst.width; x++) {
+			float sum[4] = { 0, 0, 0, 0 };
+			for (size_t k = 0; k < t.weights.size(); k++) {
+				int sy = ((t.first + (int) k) % src.height + src.height) % src.height;
+				const float *p = &rows[4 * ((size_t) sy * dst.width + x)];
+				for (int c = 0; c < 4; c++)
+					sum[c] += t.weights[k] * p[c];
+			}
+			for (int c = 0; c < 4; c++) {
+				float v = sum[c] + .5f;
+				dst.rgba[4 * ((size_t) y * dst.width + x) + c] = (unsigned char) (v < 0 ? 0 : v > 255 ? 255 : v);
+			}
+		}
+	});
+	return dst;
+}
+
+// BC1: per 4x4 block, two RGB565 endpoints and a 2-bit index per texel into
+// the endpoints and their 1/3, 2/3 blends; endpoints are the corners of the
+// block's color bounding box, inset by 1/16 of its extent to reduce error
+
+static unsigned short To565(const int c[3]) {
+	return (unsigned short) (((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3));
+}
+
+static void From565(unsigned short v, int c[3]) {
+	c[0] = ((v >> 11) & 31) * 255 / 31;
+	c[1] = ((v >> 5) & 63) * 255 / 63;
+	c[2] = (v & 31) * 255 / 31;
+}
+
+static void EncodeBlock(const Image &im, int bx, int by, unsigned char *out) {
+	int texels[16][3], lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+	for (int i = 0; i < 16; i++) {
+		int x = bx + i % 4, y = by + i / 4;
+		x = x < im.width ? x : im.width - 1;
+		y = y < im.height ? y : im.height - 1;
+		for (int c = 0; c < 3; c++) {
+			int v = texels[i][c] = im.rgba[4 * (y * im.width + x) + c];
+			lo[c] = v < lo[c] ? v : lo[c];
+			hi[c] = v > hi[c] ? v : hi[c];
+		}
+	}
+	for (int c = 0; c < 3; c++) {
+		int inset = (hi[c] - lo[c]) / 16;
+		lo[c] += inset;
+		hi[c] -= inset;
+	}
+	unsigned short c0 = To565(hi), c1 = To565(lo);
+	if (c0 < c1) {
+		unsigned short t = c0;
+		c0 = c1;
+		c1 = t;
+	}
+	unsigned int indices = 0;
+	if (c0 != c1) {  // else all texels index c0
+		int palette[4][3];
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		for (int i = 0; i < 16; i++) {
+			int best = 0, bestD = 1 << 30;
+			for (int p = 0; p < 4; p++) {
+				int dr = texels[i][0] - palette[p][0], dg = texels[i][1] - palette[p][1], db = texels[i][2] - palette[p][2];
+				int d = dr * dr + dg * dg + db * db;
+				if (d < bestD) {
+					bestD = d;
+					best = p;
+				}
+			}
+			indices |= (unsigned int) best << (2 * i);
+		}
+	}
+	unsigned char block[8] = { (unsigned char) c0, (unsigned char) (c0 >> 8), (unsigned char) c1, (unsigned char) (c1 >> 8),
+							   (unsigned char) indices, (unsigned char) (indices >> 8), (unsigned char) (indices >> 16), (unsigned char) (indices >> 24) };
+	memcpy(out, block, 8);
+}
+
+static std::vector<unsigned char> EncodeBC1(const Image &im) {
+	int bw = (im.width + 3) / 4, bh = (im.height + 3) / 4;
+	std::vector<unsigned char> out(8 * bw * bh);
+	ParallelRows(bh, [&](int by) {
+		for (int bx = 0; bx < bw; bx++)
+			EncodeBlock(im, 4 * bx, 4 * by, &out[8 * (by * bw + bx)]);
+	});
+	return out;
+}
+
+bool TextureCompressionSupported() {
+	GLint n = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+	for (int i = 0; i < n; i++) {
+		const char *e = (const char *) glGetStringi(GL_EXTENSIONS, i);
+		if (e && (!strcmp(e, "GL_EXT_texture_compression_s3tc") || !strcmp(e, "GL_EXT_texture_compression_dxt1")))
+			return true;
+	}
+	return false;
+}
+
+// Conversion: decode (on the CPU, or through LoadTexture and read back), build levels, write container
+
+static Image ReadLevel(int i) {
+	// of the texture bound to GL_TEXTURE_2D
+	Image level;
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, i, GL_TEXTURE_WIDTH, &level.width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, i, GL_TEXTURE_HEIGHT, &level.height);
+	level.rgba.resize(4 * (size_t) level.width * level.height);
+	glGetTexImage(GL_TEXTURE_2D, i, GL_RGBA, GL_UNSIGNED_BYTE, level.rgba.data());
+	return level;
+}
+
+static bool WriteContainer(Image level, bool compress, const char *path, bool gpuLevels) {
+	// gpuLevels: levels below 0 read back from the texture bound to GL_TEXTURE_2D
+	std::vector<std::vector<unsigned char>> data;
+	std::vector<LevelEntry> entries;
+	for (int i = 1; ; i++) {
+		data.push_back(compress ? EncodeBC1(level) : level.rgba);
+		entries.push_back({ (unsigned int) level.width, (unsigned int) level.height, 0, (unsigned int) data.back().size() });
+		if (level.width == 1 && level.height == 1)
+			break;
+		level = gpuLevels ? ReadLevel(i) : mipFilter == MIP_KAISER ? DownsampleKaiser(level) : Downsample(level);
+	}
+	Header h = { MAGIC, VERSION, entries[0].width, entries[0].height, (unsigned int) entries.size(),
+				 (unsigned int) (compress ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_RGBA8) };
+	unsigned int offset = sizeof(Header) + (unsigned int) (entries.size() * sizeof(LevelEntry));
+	for (LevelEntry &e : entries) {
+		offset = (offset + 15) & ~15u;
+		e.offset = offset;
+		offset += e.size;
+	}
+	MakeDirectory(cacheDir.c_str());
+	FILE *out = fopen(path, "wb");
+	if (!out)
+		return false;
+	fwrite(&h, sizeof(h), 1, out);
+	fwrite(entries.data(), sizeof(LevelEntry), entries.size(), out);
+	for (size_t i = 0; i < entries.size(); i++) {
+		static const char zeros[16] = { 0 };
+		fwrite(zeros, 1, entries[i].offset - ftell(out), out);
+		fwrite(data[i].data(), 1, data[i].size(), out);
+	}
+	bool ok = !ferror(out);
+	fclose(out);
+	if (!ok)
+		remove(path);
+	return ok;
+}
+
+bool DecodeImage(const char *filename, std::vector<unsigned char> &rgba, int &width, int &height) {
+	// as LoadTexture decodes, bottom row first; the per-thread flag, as LoadTexture sets the global one on the main thread
+	stbi_set_flip_vertically_on_load_thread(1);
+	int n = 0;
+	unsigned char *pixels = stbi_load(filename, &width, &height, &n, 4);
+	if (!pixels)
+		return false;
+	rgba.assign(pixels, pixels + 4 * (size_t) width * height);
+	stbi_image_free(pixels);
+	return width > 0 && height > 0;
+}
+
+bool ConvertImage(const std::vector<unsigned char> &rgba, int width, int height, bool compress, const char *path) {
+	if (mipFilter == MIP_GPU || width <= 0 || height <= 0 || rgba.size() < 4 * (size_t) width * height)
+		return false;
+	Image level = { width, height, rgba };
+	return WriteContainer(level, compress, path, false);
+}
+
+bool ConvertTexture(const char *filename, int textureUnit, bool compress, const char *path) {
+	GLuint texture = LoadTexture(filename, textureUnit, false);  // leaves texture bound on textureUnit
+	if (!texture)
+		return false;
+	Image level = ReadLevel(0);
+	bool ok = level.width > 0 && level.height > 0;
+	if (ok && mipFilter == MIP_GPU)
+		glGenerateMipmap(GL_TEXTURE_2D);
+	ok = ok && WriteContainer(level, compress, path, mipFilter == MIP_GPU);
+	glDeleteTextures(1, &texture);
+	return ok;
+}
+
+// Upload
+
+static GLuint Upload(const TextureFile &file, int textureUnit, TextureSampling sampling) {
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	for (int i = 0; i < file.levels; i++) {
+		int w, h, n;
+		const void *pixels = file.Level(i, w, h, n);
+		if (file.format == GL_RGBA8)
+			glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		else
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, file.format, w, h, 0, n, pixels);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, file.levels - 1);
+	SetTextureSampling(GL_TEXTURE_2D, sampling);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	return texture;
+}
+
+// Sampling
+
+float MaxTextureAnisotropy() {
+	static float max = 0;  // 0: not yet queried
+	if (max == 0) {
+		max = 1;
+		GLint n = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+		for (int i = 0; i < n; i++) {
+			const char *e = (const char *) glGetStringi(GL_EXTENSIONS, i);
+			if (e && (!strcmp(e, "GL_EXT_texture_filter_anisotropic") || !strcmp(e, "GL_ARB_texture_filter_anisotropic")))
+				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &max);
+		}
+	}
+	return max;
+}
+
+void SetTextureSampling(GLenum target, TextureSampling sampling) {
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, sampling.mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	float max = MaxTextureAnisotropy();
+	if (max > 1)
+		glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY, sampling.anisotropy < 1 ? 1 : sampling.anisotropy < max ? sampling.anisotropy : max);
+}
+
+std::string TextureCachePath(const char *filename, bool compress) {
+	// key: path, size and modification time of image (0 if absent, to run from cache alone), format
+	struct stat s;
+	bool found = !stat(filename, &s);
+	unsigned long long h = 14695981039346656037ull;
+	char key[64];
+	snprintf(key, sizeof(key), "|%lld|%lld|%i|%i|%u", found ? (long long) s.st_size : 0ll, found ? (long long) s.st_mtime : 0ll,
+			 compress, (int) mipFilter, VERSION);
+	for (const char *c : { filename, (const char *) key })
+		for (; *c; c++)
+			h = (h ^ (unsigned char) *c) * 1099511628211ull;
+	char path[512];
+	snprintf(path, sizeof(path), "%s/%016llx.tex", cacheDir.c_str(), h);
+	return path;
+}
+
+void AddTextureCacheStats(bool hit, double ms, long long gpuBytes) {
+	(hit ? stats.hits : stats.misses)++;
+	(hit ? stats.hitMs : stats.missMs) += ms;
+	stats.gpuBytes += gpuBytes;
+}
+
+GLuint LoadTextureCached(const char *filename, int textureUnit, bool compress, TextureSampling sampling) {
+	Clock::time_point start = Clock::now();
+	compress = compress && TextureCompressionSupported();
+	std::string path = TextureCachePath(filename, compress);
+	TextureFile file;
+	bool hit = file.Open(path.c_str()), converted = hit;
+	if (!hit) {
+		std::vector<unsigned char> rgba;
+		int w = 0, h = 0;
+		converted = DecodeImage(filename, rgba, w, h) && ConvertImage(rgba, w, h, compress, path.c_str());
+		converted = converted || ConvertTexture(filename, textureUnit, compress, path.c_str());
+	}
+	if (!converted || (!hit && !file.Open(path.c_str()))) {
+		printf("can't cache texture %s\n", filename);
+		return LoadTexture(filename, textureUnit);  // cache unwritable: uncached, as before
+	}
+	GLuint texture = Upload(file, textureUnit, sampling);
+	AddTextureCacheStats(hit, std::chrono::duration<double, std::milli>(Clock::now() - start).count(), file.Bytes());
+	return texture;
+}
@@ -0,0 +1,295 @@
+// TextureLoader.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "Misc.h"
+#include "TextureLoader.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double Ms(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+TextureLoader::TextureLoader(int bytesPerFrame, int nWorkers)
+	: pixels(GL_PIXEL_UNPACK_BUFFER, bytesPerFrame), bytesPerFrame(bytesPerFrame), nWorkers(nWorkers) { }
+
+TextureLoader::~TextureLoader() {
+	// GL objects must be freed by Release while context is current; workers stop here regardless
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &w : workers)
+		w.join();
+	for (Job *j : jobs)
+		delete j;
+}
+
+bool TextureLoader::Init() {
+	bool ok = pixels.Init();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	for (int i = 0; i < nWorkers; i++)
+		workers.push_back(std::thread(&TextureLoader::Work, this));
+	return ok;
+}
+
+void TextureLoader::Release() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		queue.clear();
+	}
+	wake.notify_all();
+	for (std::thread &w : workers)
+		w.join();
+	workers.clear();
+	for (Job *j : jobs)
+		delete j;
+	jobs.clear();
+	pixels.Release();
+}
+
+bool TextureLoader::Busy() {
+	return !jobs.empty();
+}
+
+bool TextureLoader::Loading(GLuint texture) const {
+	for (const Job *j : jobs)
+		if (j->texture == texture)
+			return true;
+	return false;
+}
+
+void TextureLoader::PrintStats(const char *title) const {
+	printf("%s%s%i textures loaded, %i pending, %.1f MB uploaded over %i frames\n", title ? title : "", title ? ": " : "",
+		   loaded, Pending(), uploaded / (1024. * 1024.), frames);
+}
+
+// Main thread: placeholder now, image later
+
+GLuint TextureLoader::Load(const char *filename, int textureUnit, bool compress, vec3 placeholder, TextureSampling sampling) {
+	Job *j = new Job;
+	j->filename = filename;
+	j->unit = textureUnit;
+	j->compress = compress && TextureCompressionSupported();
+	unsigned char texel[] = { (unsigned char) (255 * placeholder.x), (unsigned char) (255 * placeholder.y), (unsigned char) (255 * placeholder.z), 255 };
+	glGenTextures(1, &j->texture);
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_2D, j->texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	SetTextureSampling(GL_TEXTURE_2D, sampling);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	jobs.push_back(j);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(j);
+	}
+	wake.notify_one();
+	return j->texture;
+}
+
+// Worker: convert if not cached, map container, fault its pages in (so the upload's reads don't)
+
+void TextureLoader::Work() {
+	for (;;) {
+		Job *j = NULL;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+			if (stopping)
+				return;
+			j = queue.front();
+			queue.pop_front();
+		}
+		Clock::time_point start = Clock::now();
+		std::string path = TextureCachePath(j->filename.c_str(), j->compress);
+		State state = Mapped;
+		if (!j->file.Open(path.c_str())) {
+			// not yet cached: decode, build levels and encode here, off the main thread
+			j->hit = false;
+			if (!DecodeImage(j->filename.c_str(), j->rgba, j->width, j->height))
+				state = Missing;                   // Update decodes through LoadTexture
+			else if (ConvertImage(j->rgba, j->width, j->height, j->compress, path.c_str()) && j->file.Open(path.c_str()))
+				std::vector<unsigned char>().swap(j->rgba);
+			else
+				state = Decoded;                   // MIP_GPU, or cache unwritable
+		}
+		for (int i = 0; state == Mapped && i < j->file.levels; i++) {
+			int w, h, n;
+			const volatile char *p = (const volatile char *) j->file.Level(i, w, h, n);
+			for (int k = 0; k < n; k += 4096)
+				(void) p[k];
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		j->path = path;
+		j->ms += Ms(start);
+		j->state = state;
+	}
+}
+
+// Main thread: upload
+
+void TextureLoader::Start(Job *j) {
+	// Respecify the placeholder as the full chain; coarsest level is uploaded before any draw
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0 + j->unit);
+	glBindTexture(GL_TEXTURE_2D, j->texture);
+	for (int i = 0; i < j->file.levels; i++) {
+		int w, h, n;
+		j->file.Level(i, w, h, n);
+		if (j->file.format == GL_RGBA8)
+			glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		else
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, j->file.format, w, h, 0, n, NULL);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, j->file.levels - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, j->file.levels - 1);
+	j->level = j->file.levels - 1;
+	j->row = 0;
+	j->state = Uploading;
+}
+
+void TextureLoader::UploadUncached(Job *j) {
+	// Cache unwritable, or image unreadable: level 0 as decoded (else as LoadTexture decodes), mips by the driver
+	if (j->rgba.empty()) {
+		GLuint t = LoadTexture(j->filename.c_str(), j->unit, false);
+		if (t) {
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &j->width);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &j->height);
+			j->rgba.resize(4 * (size_t) j->width * j->height);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, j->rgba.data());
+			glDeleteTextures(1, &t);
+		}
+	}
+	j->state = Done;
+	if (j->rgba.empty()) {
+		printf("can't load texture %s\n", j->filename.c_str());  // placeholder stays
+		return;
+	}
+	glActiveTexture(GL_TEXTURE0 + j->unit);
+	glBindTexture(GL_TEXTURE_2D, j->texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, j->width, j->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, j->rgba.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	uploaded += (long long) j->rgba.size();
+	AddTextureCacheStats(false, j->ms, 4 * (long long) j->rgba.size() / 3);
+	std::vector<unsigned char>().swap(j->rgba);
+	loaded++;
+}
+
+int TextureLoader::Slice(Job *j, int budget) {
+	// Rows (of texels, or of 4x4 blocks) of the current level, through the pixel buffer, coarsest level first
+	Clock::time_point start = Clock::now();
+	glActiveTexture(GL_TEXTURE0 + j->unit);
+	glBindTexture(GL_TEXTURE_2D, j->texture);
+	bool blocks = j->file.format != GL_RGBA8;
+	int used = 0;
+	while (j->level >= 0) {
+		int w, h, n;
+		const char *data = (const char *) j->file.Level(j->level, w, h, n);
+		int texelRows = blocks ? 4 : 1, nRows = (h + texelRows - 1) / texelRows, rowBytes = n / nRows;
+		int rows = (budget - used) / rowBytes;
+		if (rows < 1) {
+			if (used)
+				break;
+			rows = 1;       // at least one row per frame, however wide
+		}
+		rows = rows < nRows - j->row ? rows : nRows - j->row;
+		int bytes = rows * rowBytes, y = j->row * texelRows, height = rows * texelRows < h - y ? rows * texelRows : h - y;
+		const char *src = data + j->row * rowBytes;
+		GLintptr offset = 0;
+		void *dst = pixels.Alloc(bytes, offset);
+		if (dst) {
+			memcpy(dst, src, bytes);
+			pixels.Commit();
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixels.Buffer());
+		}
+		else
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);  // row wider than buffer region: directly from mapping
+		const void *from = dst ? (const void *) offset : (const void *) src;
+		if (blocks)
+			glCompressedTexSubImage2D(GL_TEXTURE_2D, j->level, 0, y, w, height, j->file.format, bytes, from);
+		else
+			glTexSubImage2D(GL_TEXTURE_2D, j->level, 0, y, w, height, GL_RGBA, GL_UNSIGNED_BYTE, from);
+		used += bytes;
+		j->row += rows;
+		if (j->row == nRows) {
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, j->level);  // level complete: sample it
+			j->level--;
+			j->row = 0;
+		}
+	}
+	uploaded += used;
+	j->ms += Ms(start);
+	if (j->level < 0) {
+		AddTextureCacheStats(j->hit, j->ms, j->file.Bytes());
+		j->file.Close();
+		j->state = Done;
+		loaded++;
+	}
+	return used;
+}
+
+bool TextureLoader::Update() {
+	std::vector<Job *> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (Job *j : jobs)
+			if (j->state != Queued)
+				ready.push_back(j);
+	}
+	if (ready.empty())
+		return false;
+	frames++;
+	int budget = bytesPerFrame;
+	bool converted = false, began = false;
+	for (Job *j : ready) {
+		if (j->state == Missing || j->state == Decoded) {
+			// worker couldn't cache it: convert here if that needs the context, one per frame, else upload uncached
+			if (converted)
+				continue;
+			converted = true;
+			Clock::time_point start = Clock::now();
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			bool context = j->state == Missing || GetMipFilter() == MIP_GPU;
+			if (context && ConvertTexture(j->filename.c_str(), j->unit, j->compress, j->path.c_str()) && j->file.Open(j->path.c_str())) {
+				std::vector<unsigned char>().swap(j->rgba);
+				j->ms += Ms(start);
+				j->state = Mapped;
+			}
+			else {
+				j->ms += Ms(start);
+				UploadUncached(j);
+				continue;
+			}
+		}
+		if (budget <= 0)
+			break;
+		if (!began) {
+			pixels.BeginFrame();
+			began = true;
+		}
+		if (j->state == Mapped)
+			Start(j);
+		budget -= Slice(j, budget);
+	}
+	if (began)
+		pixels.EndFrame();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	for (size_t i = 0; i < jobs.size(); )
+		if (jobs[i]->state == Done) {
+			delete jobs[i];
+			jobs.erase(jobs.begin() + i);
+		}
+		else
+			i++;
+	return true;
+}
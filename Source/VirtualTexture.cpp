@@ -0,0 +1,517 @@
+// VirtualTexture.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+#include "VirtualTexture.h"
+
+#ifdef _WIN32
+#define Seek(f, offset) _fseeki64(f, offset, SEEK_SET)
+#else
+#define Seek(f, offset) fseeko(f, (off_t) (offset), SEEK_SET)
+#endif
+
+static const unsigned int MAGIC = 0x54565447, VERSION = 1; // 'GTVT'
+static const int TILE_BYTES = 4 * VT_TILE * VT_TILE;
+static const long long DATA_OFFSET = 4096;                 // tiles start page aligned
+static const int MAX_UPLOADS = 16, MAX_IN_FLIGHT = 64;     // tiles per frame, tiles queued or loaded
+
+// Tile file: header, then every tile of every level, finest level first, row-major
+
+struct Header {
+	unsigned int magic, version, width, height, levels, tile, border, pad;
+};
+
+static std::vector<VirtualLevel> Levels(int width, int height) {
+	// halve until one page covers the level
+	std::vector<VirtualLevel> levels;
+	for (int w = width, h = height, first = 0, row = 0; ; w = w > 1 ? w / 2 : 1, h = h > 1 ? h / 2 : 1) {
+		VirtualLevel l = { w, h, (w + VT_CONTENT - 1) / VT_CONTENT, (h + VT_CONTENT - 1) / VT_CONTENT, first, row };
+		levels.push_back(l);
+		first += l.pagesX * l.pagesY;
+		row += l.pagesY;
+		if (l.pagesX == 1 && l.pagesY == 1)
+			return levels;
+	}
+}
+
+static long long TileOffset(int page) {
+	return DATA_OFFSET + (long long) page * TILE_BYTES;
+}
+
+static int Wrap(int x, int n) {
+	return ((x % n) + n) % n;
+}
+
+static int Clamp(int y, int n) {
+	return y < 0 ? 0 : y < n ? y : n - 1;
+}
+
+// Build
+
+static bool ReadTile(FILE *f, int page, unsigned char *tile) {
+	return !Seek(f, TileOffset(page)) && fread(tile, 1, TILE_BYTES, f) == (size_t) TILE_BYTES;
+}
+
+static bool WriteTile(FILE *f, int page, const unsigned char *tile) {
+	return !Seek(f, TileOffset(page)) && fwrite(tile, 1, TILE_BYTES, f) == (size_t) TILE_BYTES;
+}
+
+static void Insert(FILE *f, const VirtualLevel &l0, int width, int height,
+				   const std::vector<unsigned char> &src, int x0, int y0, int w, int h) {
+	// every level 0 tile that has a texel (border included) from this source: read, patch, write
+	std::vector<unsigned char> tile(TILE_BYTES);
+	for (int ty = 0; ty < l0.pagesY; ty++) {
+		int gy[VT_TILE];
+		bool rows = false;
+		for (int r = 0; r < VT_TILE; r++) {
+			gy[r] = Clamp(ty * VT_CONTENT - VT_BORDER + r, height);
+			rows |= gy[r] >= y0 && gy[r] < y0 + h;
+		}
+		for (int tx = 0; rows && tx < l0.pagesX; tx++) {
+			int gx[VT_TILE];
+			bool columns = false;
+			for (int c = 0; c < VT_TILE; c++) {
+				gx[c] = Wrap(tx * VT_CONTENT - VT_BORDER + c, width);
+				columns |= gx[c] >= x0 && gx[c] < x0 + w;
+			}
+			if (!columns)
+				continue;
+			int page = l0.first + ty * l0.pagesX + tx;
+			ReadTile(f, page, tile.data());
+			for (int r = 0; r < VT_TILE; r++)
+				if (gy[r] >= y0 && gy[r] < y0 + h)
+					for (int c = 0; c < VT_TILE; c++)
+						if (gx[c] >= x0 && gx[c] < x0 + w)
+							memcpy(&tile[4 * (r * VT_TILE + c)], &src[4 * ((size_t) (gy[r] - y0) * w + gx[c] - x0)], 4);
+			WriteTile(f, page, tile.data());
+		}
+	}
+}
+
+static void Reduce(FILE *f, const VirtualLevel &fine, const VirtualLevel &coarse) {
+	// 2x2 box filter of the level below, read a tile at a time through a small cache
+	std::unordered_map<int, std::vector<unsigned char>> cache;
+	size_t capacity = 4 * fine.pagesX + 16;  // two rows of fine tiles per coarse row, and then some
+	auto Texel = [&](int x, int y) -> const unsigned char * {
+		// pointers stay valid until the cache is cleared, only between coarse tiles
+		int px = x / VT_CONTENT, py = y / VT_CONTENT, page = fine.first + py * fine.pagesX + px;
+		auto t = cache.find(page);
+		if (t == cache.end()) {
+			t = cache.emplace(page, std::vector<unsigned char>(TILE_BYTES)).first;
+			ReadTile(f, page, t->second.data());
+		}
+		return &t->second[4 * ((VT_BORDER + y - py * VT_CONTENT) * VT_TILE + VT_BORDER + x - px * VT_CONTENT)];
+	};
+	std::vector<unsigned char> tile(TILE_BYTES);
+	for (int ty = 0; ty < coarse.pagesY; ty++)
+		for (int tx = 0; tx < coarse.pagesX; tx++) {
+			if (cache.size() >= capacity)
+				cache.clear();                   // a coarse tile reads at most 4x4 fine tiles, so the cache overshoots little
+			for (int r = 0; r < VT_TILE; r++)
+				for (int c = 0; c < VT_TILE; c++) {
+					int x = Wrap(tx * VT_CONTENT - VT_BORDER + c, coarse.width), y = Clamp(ty * VT_CONTENT - VT_BORDER + r, coarse.height);
+					int x0 = Clamp(2 * x, fine.width), y0 = Clamp(2 * y, fine.height);
+					int x1 = Clamp(x0 + 1, fine.width), y1 = Clamp(y0 + 1, fine.height);
+					const unsigned char *a = Texel(x0, y0), *b = Texel(x1, y0), *d = Texel(x0, y1), *e = Texel(x1, y1);
+					for (int k = 0; k < 4; k++)
+						tile[4 * (r * VT_TILE + c) + k] = (unsigned char) ((a[k] + b[k] + d[k] + e[k] + 2) / 4);
+				}
+			WriteTile(f, coarse.first + ty * coarse.pagesX + tx, tile.data());
+		}
+}
+
+bool BuildVirtualTexture(const std::vector<std::string> &images, int columns, const char *path) {
+	if (images.empty() || columns < 1)
+		return false;
+	int rows = ((int) images.size() + columns - 1) / columns, w = 0, h = 0, width = 0, height = 0;
+	std::vector<VirtualLevel> levels;
+	FILE *out = fopen(path, "w+b");
+	if (!out)
+		return false;
+	bool ok = true;
+	for (size_t i = 0; ok && i < images.size(); i++) {
+		std::vector<unsigned char> src;
+		int sw, sh;
+		if (!DecodeImage(images[i].c_str(), src, sw, sh) || (i > 0 && (sw != w || sh != h))) {
+			printf("can't add %s to %s\n", images[i].c_str(), path);
+			ok = false;
+			break;
+		}
+		if (i == 0) {
+			// size the file up front; tiles not yet written read as zeros
+			w = sw;
+			h = sh;
+			width = columns * w;
+			height = rows * h;
+			levels = Levels(width, height);
+			const VirtualLevel &top = levels.back();
+			Header header = { MAGIC, VERSION, (unsigned int) width, (unsigned int) height, (unsigned int) levels.size(), VT_TILE, VT_BORDER, 0 };
+			ok = fwrite(&header, sizeof(header), 1, out) == 1 && !Seek(out, TileOffset(top.first + 1) - 1) && fputc(0, out) == 0;
+		}
+		Insert(out, levels[0], width, height, src, (int) (i % columns) * w, (int) (i / columns) * h, w, h);
+	}
+	for (size_t l = 1; ok && l < levels.size(); l++)
+		Reduce(out, levels[l - 1], levels[l]);
+	ok = ok && !ferror(out);
+	fclose(out);
+	if (!ok)
+		remove(path);
+	return ok;
+}
+
+bool BuildVirtualTexture(const char *image, const char *path) {
+	return BuildVirtualTexture(std::vector<std::string>(1, image), 1, path);
+}
+
+// Setup
+
+VirtualTexture::VirtualTexture(int atlasUnit, int indirectionUnit, int feedbackScale)
+	: atlasUnit(atlasUnit), indirectionUnit(indirectionUnit), feedbackScale(feedbackScale),
+	  pixels(GL_PIXEL_UNPACK_BUFFER, MAX_UPLOADS * TILE_BYTES) { }
+
+VirtualTexture::~VirtualTexture() {
+	// GL objects must be freed by Release while context is current; worker stops here regardless
+	Stop();
+}
+
+bool VirtualTexture::Init(const char *path, int budgetMB) {
+	Release();
+	const Header *h = file.Open(path) ? (const Header *) file.data : NULL;
+	if (!h || file.size < sizeof(Header) || h->magic != MAGIC || h->version != VERSION ||
+		h->tile != VT_TILE || h->border != VT_BORDER) {
+		printf("can't open virtual texture %s\n", path);
+		file.Close();
+		return false;
+	}
+	width = h->width;
+	height = h->height;
+	levels = Levels(width, height);
+	nPages = levels.back().first + 1;
+	if ((int) h->levels != (int) levels.size() || (long long) file.size < TileOffset(nPages)) {
+		printf("%s is truncated\n", path);
+		file.Close();
+		return false;
+	}
+	slot.assign(nPages, -1);
+	lastUsed.assign(nPages, -1);
+	requested.assign(nPages, -1);
+	queued.assign(nPages, 0);
+	// atlas: as many tiles as the budget allows, square
+	GLint maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	atlasTiles = (int) sqrt((double) budgetMB * 1024 * 1024 / TILE_BYTES);
+	atlasTiles = std::max(2, std::min(atlasTiles, (int) maxSize / VT_TILE));
+	slotPage.assign(atlasTiles * atlasTiles, -1);
+	glGenTextures(1, &atlas);
+	glActiveTexture(GL_TEXTURE0 + atlasUnit);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasTiles * VT_TILE, atlasTiles * VT_TILE, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	// indirection: one texel per page, levels stacked, finest at row 0
+	int rows = levels.back().row + 1;
+	table.assign(4 * levels[0].pagesX * rows, 0);
+	glGenTextures(1, &indirection);
+	glActiveTexture(GL_TEXTURE0 + indirectionUnit);
+	glBindTexture(GL_TEXTURE_2D, indirection);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8UI, levels[0].pagesX, rows, 0, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, table.data());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	bool ok = pixels.Init();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	stopping = false;
+	worker = std::thread(&VirtualTexture::Work, this);
+	stale = true;
+	return ok;
+}
+
+void VirtualTexture::Stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		loads.clear();
+		loaded.clear();
+	}
+	wake.notify_all();
+	if (worker.joinable())
+		worker.join();
+}
+
+void VirtualTexture::Release() {
+	Stop();
+	if (atlas)
+		glDeleteTextures(1, &atlas);
+	if (indirection)
+		glDeleteTextures(1, &indirection);
+	if (framebuffer) {
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &feedback);
+		glDeleteRenderbuffers(1, &depth);
+		glDeleteBuffers(2, readback);
+	}
+	atlas = indirection = framebuffer = feedback = depth = readback[0] = readback[1] = 0;
+	readPending[0] = readPending[1] = false;
+	fbWidth = fbHeight = 0;
+	pixels.Release();
+	file.Close();
+}
+
+int VirtualTexture::Resident() const {
+	int n = 0;
+	for (int p : slotPage)
+		n += p >= 0;
+	return n;
+}
+
+void VirtualTexture::PrintStats(const char *title) const {
+	printf("%s%s%i/%i tiles resident (%.0f MB atlas), %i pages requested, %i uploads, %i evictions, %i dropped over budget\n",
+		   title ? title : "", title ? ": " : "", Resident(), atlasTiles * atlasTiles,
+		   (double) atlasTiles * atlasTiles * TILE_BYTES / (1024 * 1024), lastRequested, uploads, evictions, dropped);
+}
+
+// Worker: copy a tile out of the mapping, faulting its pages in from disk here rather than in Upload
+
+void VirtualTexture::Work() {
+	for (;;) {
+		int page = 0;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this]() { return stopping || !loads.empty(); });
+			if (stopping)
+				return;
+			page = loads.front();
+			loads.pop_front();
+		}
+		Tile t;
+		t.page = page;
+		const unsigned char *src = (const unsigned char *) file.data + TileOffset(page);
+		t.rgba.assign(src, src + TILE_BYTES);
+		std::lock_guard<std::mutex> lock(mutex);
+		loaded.push_back(std::move(t));
+	}
+}
+
+// Feedback: pages drawn last frame, at 1/feedbackScale resolution, read back a frame late
+
+void VirtualTexture::BeginFeedback(int w, int h) {
+	w = std::max(1, w / feedbackScale);
+	h = std::max(1, h / feedbackScale);
+	if (!framebuffer) {
+		glGenFramebuffers(1, &framebuffer);
+		glGenRenderbuffers(1, &feedback);
+		glGenRenderbuffers(1, &depth);
+		glGenBuffers(2, readback);
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	if (w != fbWidth || h != fbHeight) {
+		glBindRenderbuffer(GL_RENDERBUFFER, feedback);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA16UI, w, h);
+		glBindRenderbuffer(GL_RENDERBUFFER, depth);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, feedback);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+		for (GLuint b : readback) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, b);
+			glBufferData(GL_PIXEL_PACK_BUFFER, 8 * w * h, NULL, GL_STREAM_READ);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		readPending[0] = readPending[1] = false;  // sized for the old target
+		fbWidth = w;
+		fbHeight = h;
+	}
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glViewport(0, 0, fbWidth, fbHeight);
+	GLuint none[4] = { 0, 0, 0, 0 };
+	glClearBufferuiv(GL_COLOR, 0, none);
+	glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void VirtualTexture::EndFeedback() {
+	// into a pack buffer: returns without waiting for the GPU; mapped next frame by Update
+	int b = frame & 1;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback[b]);
+	glReadPixels(0, 0, fbWidth, fbHeight, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, NULL);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	readPending[b] = true;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+bool VirtualTexture::Request(int level, int x, int y, std::vector<int> &missing) {
+	int p = PageIndex(level, x, y);
+	if (requested[p] == frame)
+		return false;
+	requested[p] = frame;
+	lastRequested++;
+	if (slot[p] >= 0)
+		lastUsed[p] = frame;
+	else if (!queued[p])
+		missing.push_back(p);
+	return true;
+}
+
+void VirtualTexture::ReadFeedback() {
+	std::vector<int> missing;
+	lastRequested = 0;
+	int nLevels = (int) levels.size(), b = (frame - 1) & 1;
+	// coarsest level always: the fallback for every page
+	const VirtualLevel &top = levels.back();
+	for (int y = 0; y < top.pagesY; y++)
+		for (int x = 0; x < top.pagesX; x++)
+			Request(nLevels - 1, x, y, missing);
+	if (readPending[b]) {
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback[b]);
+		const unsigned short *p = (const unsigned short *) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, 8 * fbWidth * fbHeight, GL_MAP_READ_BIT);
+		for (int i = 0; p && i < fbWidth * fbHeight; i++, p += 4)
+			if (p[3] && p[2] < nLevels)
+				// the page and its ancestors, until one already requested (its ancestors were too)
+				for (int l = p[2], x = p[0], y = p[1]; l < nLevels; l++, x /= 2, y /= 2)
+					if (!Request(l, std::min(x, levels[l].pagesX - 1), std::min(y, levels[l].pagesY - 1), missing))
+						break;
+		if (p)
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		readPending[b] = false;
+	}
+	// coarsest first (later in the file), so a fallback arrives before its detail
+	std::sort(missing.begin(), missing.end(), [](int a, int b) { return a > b; });
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int p : missing) {
+			if ((int) (loads.size() + loaded.size()) >= MAX_IN_FLIGHT)
+				break;
+			loads.push_back(p);
+			queued[p] = 1;
+		}
+	}
+	wake.notify_one();
+}
+
+// Residency: least recently requested tile gives up its slot
+
+int VirtualTexture::FreeSlot() {
+	int lru = -1;
+	for (int s = 0; s < (int) slotPage.size(); s++) {
+		if (slotPage[s] < 0)
+			return s;
+		int used = lastUsed[slotPage[s]];
+		if (used < frame && (lru < 0 || used < lastUsed[slotPage[lru]]))
+			lru = s;
+	}
+	if (lru >= 0) {
+		slot[slotPage[lru]] = -1;
+		slotPage[lru] = -1;
+		evictions++;
+	}
+	return lru;
+}
+
+void VirtualTexture::Upload() {
+	std::vector<Tile> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while (!loaded.empty() && (int) ready.size() < MAX_UPLOADS) {
+			ready.push_back(std::move(loaded.front()));
+			loaded.pop_front();
+		}
+	}
+	if (ready.empty())
+		return;
+	pixels.BeginFrame();
+	glActiveTexture(GL_TEXTURE0 + atlasUnit);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	for (Tile &t : ready) {
+		queued[t.page] = 0;
+		if (requested[t.page] < frame - 2)
+			continue;                  // no longer in view
+		int s = FreeSlot();
+		if (s < 0) {
+			dropped++;                 // every slot wanted this frame: budget too small for the view
+			continue;
+		}
+		slotPage[s] = t.page;
+		slot[t.page] = s;
+		lastUsed[t.page] = frame;
+		GLintptr offset = 0;
+		void *dst = pixels.Alloc(TILE_BYTES, offset);
+		if (dst) {
+			memcpy(dst, t.rgba.data(), TILE_BYTES);
+			pixels.Commit();
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixels.Buffer());
+		}
+		else
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		const void *from = dst ? (const void *) offset : (const void *) t.rgba.data();
+		glTexSubImage2D(GL_TEXTURE_2D, 0, (s % atlasTiles) * VT_TILE, (s / atlasTiles) * VT_TILE, VT_TILE, VT_TILE,
+						GL_RGBA, GL_UNSIGNED_BYTE, from);
+		uploads++;
+		stale = true;
+	}
+	pixels.EndFrame();
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void VirtualTexture::RebuildIndirection() {
+	// coarse to fine: a page not resident takes its parent's entry
+	int nLevels = (int) levels.size(), stride = levels[0].pagesX;
+	for (int l = nLevels - 1; l >= 0; l--) {
+		const VirtualLevel &v = levels[l];
+		for (int y = 0; y < v.pagesY; y++)
+			for (int x = 0; x < v.pagesX; x++) {
+				unsigned char *e = &table[4 * ((v.row + y) * stride + x)];
+				int s = slot[PageIndex(l, x, y)];
+				if (s >= 0) {
+					e[0] = (unsigned char) (s % atlasTiles);
+					e[1] = (unsigned char) (s / atlasTiles);
+					e[2] = (unsigned char) l;
+					e[3] = 1;
+				}
+				else if (l + 1 < nLevels) {
+					const VirtualLevel &p = levels[l + 1];
+					memcpy(e, &table[4 * ((p.row + std::min(y / 2, p.pagesY - 1)) * stride + std::min(x / 2, p.pagesX - 1))], 4);
+				}
+				else
+					memset(e, 0, 4);
+			}
+	}
+	glActiveTexture(GL_TEXTURE0 + indirectionUnit);
+	glBindTexture(GL_TEXTURE_2D, indirection);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, stride, levels.back().row + 1, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, table.data());
+	stale = false;
+}
+
+void VirtualTexture::Update() {
+	if (!atlas)
+		return;
+	frame++;
+	ReadFeedback();
+	Upload();
+	if (stale)
+		RebuildIndirection();
+}
+
+// Draw
+
+void VirtualTexture::Use(GLuint program, bool feedbackPass) {
+	glActiveTexture(GL_TEXTURE0 + atlasUnit);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glActiveTexture(GL_TEXTURE0 + indirectionUnit);
+	glBindTexture(GL_TEXTURE_2D, indirection);
+	glUniform1i(glGetUniformLocation(program, "vtAtlas"), atlasUnit);
+	glUniform1i(glGetUniformLocation(program, "vtIndirection"), indirectionUnit);
+	glUniform2i(glGetUniformLocation(program, "vtSize"), width, height);
+	glUniform1i(glGetUniformLocation(program, "vtLevels"), (int) levels.size());
+	glUniform1i(glGetUniformLocation(program, "vtAtlasTiles"), atlasTiles);
+	// feedback target is smaller: derivatives are feedbackScale times larger
+	glUniform1f(glGetUniformLocation(program, "vtBias"), feedbackPass ? -log2f((float) feedbackScale) : 0.f);
+}
@@ -0,0 +1,63 @@
+// Wireframe.cpp
+// (c) Justin Thoreson
+// 19 October 2026
+
+#include <array>
+#include <map>
+#include <unordered_set>
+#include "Wireframe.h"
+
+// Unique edges
+
+std::vector<int> UniqueEdges(const int3 *triangles, int nTriangles, const vec3 *points, int nPoints) {
+	// canonical vertex: first index at its position
+	std::vector<int> canonical(nPoints);
+	std::map<std::array<float, 3>, int> firstAt;
+	for (int i = 0; i < nPoints; i++) {
+		auto f = firstAt.insert({ { points[i].x, points[i].y, points[i].z }, i }).first;
+		canonical[i] = f->second;
+	}
+	std::vector<int> edges;
+	std::unordered_set<unsigned long long> seen;
+	for (int t = 0; t < nTriangles; t++) {
+		int v[] = { triangles[t].i1, triangles[t].i2, triangles[t].i3 };
+		for (int k = 0; k < 3; k++) {
+			int a = v[k], b = v[(k + 1) % 3];
+			if (points) {
+				a = canonical[a];
+				b = canonical[b];
+			}
+			if (a == b)
+				continue;
+			unsigned long long key = a < b ? (unsigned long long) a << 32 | b : (unsigned long long) b << 32 | a;
+			if (seen.insert(key).second) {
+				edges.push_back(a);
+				edges.push_back(b);
+			}
+		}
+	}
+	return edges;
+}
+
+// Wireframe
+
+bool Wireframe::Init(const int3 *triangles, int nTriangles, const vec3 *points, int nPoints) {
+	std::vector<int> edges = UniqueEdges(triangles, nTriangles, points, nPoints);
+	nEdges = (int) edges.size() / 2;
+	if (!edgeBuffer)
+		glGenBuffers(1, &edgeBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, edgeBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, edges.size() * sizeof(int), edges.data(), GL_STATIC_DRAW);
+	return nEdges > 0;
+}
+
+void Wireframe::Release() {
+	glDeleteBuffers(1, &edgeBuffer);
+	edgeBuffer = 0;
+	nEdges = 0;
+}
+
+void Wireframe::Draw() {
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, edgeBuffer);
+	glDrawElements(GL_LINES, 2 * nEdges, GL_UNSIGNED_INT, (void *) 0);
+}